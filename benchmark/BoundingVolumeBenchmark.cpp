@@ -0,0 +1,64 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "wrapper/BoundingVolume.hpp"
+#include "wrapper/Vertex.hpp"
+
+using namespace Concerto::Graphics::Wrapper;
+
+#define VERTEX_COUNT (1 << 20)
+#define ITERATIONS 50
+
+template<typename Kernel>
+double measure(const char* name, Kernel&& kernel)
+{
+	kernel(); // warm up the caches
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < ITERATIONS; ++i)
+		kernel();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	double verticesPerSecond = static_cast<double>(VERTEX_COUNT) * ITERATIONS / elapsed.count();
+	std::cout << name << ": " << verticesPerSecond / 1e6 << " Mvertices/s" << std::endl;
+	return verticesPerSecond;
+}
+
+int main()
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> distribution(-100.f, 100.f);
+	std::vector<Vertex> vertices(VERTEX_COUNT);
+	std::vector<glm::vec3> positions(VERTEX_COUNT);
+	for (std::size_t i = 0; i < vertices.size(); ++i)
+	{
+		vertices[i].position = glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+		positions[i] = vertices[i].position;
+	}
+
+	std::cout << "Bounds kernels: " << getBoundingVolumeKernelName() << ", " << VERTEX_COUNT << " vertices"
+			  << std::endl;
+	BoundingBox box{};
+	BoundingBox scalarBox{};
+	BoundingSphere sphere{};
+	BoundingSphere scalarSphere{};
+	double scalarBoxRate = measure("Bounding box (scalar)", [&]() { scalarBox = computeBoundingBoxScalar(vertices); });
+	double boxRate = measure("Bounding box", [&]() { box = computeBoundingBox(vertices); });
+	double scalarSphereRate = measure("Bounding sphere (scalar)",
+			[&]() { scalarSphere = computeBoundingSphereScalar(positions); });
+	double sphereRate = measure("Bounding sphere", [&]() { sphere = computeBoundingSphere(positions); });
+	std::cout << "Speedup: box x" << boxRate / scalarBoxRate << ", sphere x" << sphereRate / scalarSphereRate
+			  << std::endl;
+
+	if (box.min != scalarBox.min || box.max != scalarBox.max || sphere.center != scalarSphere.center ||
+		sphere.radius != scalarSphere.radius)
+	{
+		std::cerr << "The SIMD and scalar kernels disagree" << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,155 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+#include "wrapper/BoundingVolume.hpp"
+#include "wrapper/Meshlet.hpp"
+#include "wrapper/Vertex.hpp"
+
+using namespace Concerto::Graphics::Wrapper;
+
+// Every cube face is a (2 * PATCH_SIZE)^2 quad grid, written patch by patch. A patch has
+// (PATCH_SIZE + 1)^2 = 64 vertices so that buildMeshlets() makes exactly one meshlet per patch.
+#define PATCH_SIZE 7
+#define FACE_SIZE (2 * PATCH_SIZE)
+#define FACE_COUNT 6
+#define PATCH_TRIANGLES (2 * PATCH_SIZE * PATCH_SIZE)
+#define MESHLET_COUNT (FACE_COUNT * 4)
+#define TRIANGLE_COUNT (MESHLET_COUNT * PATCH_TRIANGLES)
+
+struct Sphere
+{
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+};
+
+// Cube projected on the unit sphere, each face has its own vertices. inward flips the winding, for a closed
+// mesh seen from the inside.
+Sphere makeSphere(bool inward)
+{
+	const glm::vec3 normals[FACE_COUNT] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+	const glm::vec3 rights[FACE_COUNT] = {{0, 0, -1}, {0, 0, 1}, {1, 0, 0}, {1, 0, 0}, {1, 0, 0}, {-1, 0, 0}};
+	const glm::vec3 ups[FACE_COUNT] = {{0, 1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}, {0, 1, 0}, {0, 1, 0}};
+	Sphere sphere;
+	for (int face = 0; face < FACE_COUNT; ++face)
+	{
+		const auto base = static_cast<std::uint32_t>(sphere.vertices.size());
+		for (int y = 0; y <= FACE_SIZE; ++y)
+		{
+			for (int x = 0; x <= FACE_SIZE; ++x)
+			{
+				const float s = 2.f * static_cast<float>(x) / FACE_SIZE - 1.f;
+				const float t = 2.f * static_cast<float>(y) / FACE_SIZE - 1.f;
+				Vertex vertex{};
+				vertex.position = glm::normalize(normals[face] + rights[face] * s + ups[face] * t);
+				vertex.normal = inward ? -vertex.position : vertex.position;
+				sphere.vertices.push_back(vertex);
+			}
+		}
+		auto index = [&](int x, int y) { return base + static_cast<std::uint32_t>(y * (FACE_SIZE + 1) + x); };
+		for (int patch = 0; patch < 4; ++patch)
+		{
+			const int patchX = (patch % 2) * PATCH_SIZE;
+			const int patchY = (patch / 2) * PATCH_SIZE;
+			for (int y = patchY; y < patchY + PATCH_SIZE; ++y)
+			{
+				for (int x = patchX; x < patchX + PATCH_SIZE; ++x)
+				{
+					// right x up is the face normal, so a, b, c is counter-clockwise seen from the outside
+					const std::uint32_t a = index(x, y), b = index(x + 1, y), c = index(x + 1, y + 1), d = index(x, y + 1);
+					if (inward)
+						sphere.indices.insert(sphere.indices.end(), {a, c, b, a, d, c});
+					else
+						sphere.indices.insert(sphere.indices.end(), {a, b, c, a, c, d});
+				}
+			}
+		}
+	}
+	return sphere;
+}
+
+bool checkLimits(const char* name, const Meshlets& meshlets)
+{
+	std::uint32_t nextIndex = 0;
+	for (const Meshlet& meshlet: meshlets)
+	{
+		if (meshlet.vertexCount > MaxMeshletVertices || meshlet.triangleCount > MaxMeshletTriangles)
+		{
+			std::cerr << name << ": meshlet with " << meshlet.vertexCount << " vertices and " << meshlet.triangleCount
+					  << " triangles" << std::endl;
+			return false;
+		}
+		if (meshlet.firstIndex != nextIndex)
+		{
+			std::cerr << name << ": the meshlets are not contiguous" << std::endl;
+			return false;
+		}
+		nextIndex += meshlet.triangleCount * 3;
+	}
+	if (meshlets.size() != MESHLET_COUNT || nextIndex != TRIANGLE_COUNT * 3)
+	{
+		std::cerr << name << ": " << meshlets.size() << " meshlets covering " << nextIndex / 3 << " triangles, expected "
+				  << MESHLET_COUNT << " meshlets covering " << TRIANGLE_COUNT << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool checkCulling(const char* name, const Meshlets& meshlets, const glm::mat4& viewProjection,
+		const glm::vec3& cameraPosition, const MeshletCullingStatistics& expected)
+{
+	std::vector<IndexRange> ranges;
+	MeshletCullingStatistics statistics = cullMeshlets(meshlets, extractFrustum(viewProjection), cameraPosition,
+			ranges);
+	std::size_t rangeTriangles = 0;
+	for (const IndexRange& range: ranges)
+		rangeTriangles += range.indexCount / 3;
+	const bool success = statistics.visibleMeshlets == expected.visibleMeshlets &&
+						 statistics.visibleTriangles == expected.visibleTriangles &&
+						 statistics.frustumCulledTriangles == expected.frustumCulledTriangles &&
+						 statistics.backfaceCulledTriangles == expected.backfaceCulledTriangles &&
+						 rangeTriangles == expected.visibleTriangles;
+	std::cout << name << ": " << statistics.visibleMeshlets << " meshlets, " << statistics.visibleTriangles
+			  << " visible triangles, " << statistics.frustumCulledTriangles << " frustum culled, "
+			  << statistics.backfaceCulledTriangles << " backface culled" << (success ? "" : " FAILED") << std::endl;
+	if (!success)
+		std::cerr << name << ": expected " << expected.visibleMeshlets << " meshlets, " << expected.visibleTriangles
+				  << " visible triangles, " << expected.frustumCulledTriangles << " frustum culled, "
+				  << expected.backfaceCulledTriangles << " backface culled" << std::endl;
+	return success;
+}
+
+int main()
+{
+	const Sphere outside = makeSphere(false);
+	const Sphere inside = makeSphere(true);
+	const Meshlets outsideMeshlets = buildMeshlets(outside.indices, outside.vertices);
+	const Meshlets insideMeshlets = buildMeshlets(inside.indices, inside.vertices);
+	if (!checkLimits("Outward sphere", outsideMeshlets) || !checkLimits("Inward sphere", insideMeshlets))
+		return 1;
+
+	const glm::mat4 projection = glm::perspectiveRH_ZO(glm::radians(90.f), 1.f, 0.1f, 100.f);
+	const glm::vec3 up(0.f, 1.f, 0.f);
+	bool success = true;
+
+	// From the center of the inward sphere every triangle faces the camera, the box holds the whole sphere
+	const glm::mat4 box = glm::orthoRH_ZO(-2.f, 2.f, -2.f, 2.f, -2.f, 2.f);
+	success &= checkCulling("Everything visible", insideMeshlets, box, glm::vec3(0.f),
+			{MESHLET_COUNT, TRIANGLE_COUNT, 0, 0});
+
+	const glm::vec3 camera(0.f, 0.f, 3.f);
+	success &= checkCulling("Outside the frustum", outsideMeshlets,
+			projection * glm::lookAtRH(camera, glm::vec3(0.f, 0.f, 10.f), up), camera,
+			{0, 0, TRIANGLE_COUNT, 0});
+
+	// Looking at the sphere from 3 radii away, every patch of the z < 0 half only has back faces
+	success &= checkCulling("Back half culled", outsideMeshlets,
+			projection * glm::lookAtRH(camera, glm::vec3(0.f), up), camera,
+			{MESHLET_COUNT / 2, TRIANGLE_COUNT / 2, 0, TRIANGLE_COUNT / 2});
+	return success ? 0 : 1;
+}
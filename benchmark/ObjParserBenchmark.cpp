@@ -0,0 +1,144 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include "wrapper/ObjParser.hpp"
+#include "wrapper/Vertex.hpp"
+
+using namespace Concerto::Graphics::Wrapper;
+
+#define GRID_SIZE 768
+#define ITERATIONS 5
+
+// Decimal close to the middle of two floats, where an approximate parse and a correctly rounded one disagree
+double halfway(float value)
+{
+	return (static_cast<double>(value) + static_cast<double>(std::nextafter(value, value + 1.f))) / 2.0;
+}
+
+// Grid of quads with a triangle pair every few cells and the odd rows using relative indices,
+// the x coordinates are halfway cases so that the float parsing rounding shows up
+void writeObj(const std::string& fileName)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::ofstream file(fileName);
+	file << std::setprecision(9);
+	for (int y = 0; y < GRID_SIZE; ++y)
+	{
+		for (int x = 0; x < GRID_SIZE; ++x)
+		{
+			const float position = static_cast<float>(x + distribution(generator) * 0.25);
+			file << "v " << std::setprecision(15) << halfway(position) << std::setprecision(9) << ' '
+				 << distribution(generator) * 1e-3 << ' ' << y + distribution(generator) * 0.25 << '\n';
+			file << "vt " << (x + distribution(generator) * 0.1) / GRID_SIZE << ' '
+				 << (y + distribution(generator) * 0.1) / GRID_SIZE << '\n';
+			file << "vn " << distribution(generator) << ' ' << 1.0 << ' ' << distribution(generator) << '\n';
+		}
+	}
+	const int count = GRID_SIZE * GRID_SIZE;
+	for (int y = 0; y + 1 < GRID_SIZE; ++y)
+	{
+		for (int x = 0; x + 1 < GRID_SIZE; ++x)
+		{
+			int corners[4] = {y * GRID_SIZE + x + 1, y * GRID_SIZE + x + 2, (y + 1) * GRID_SIZE + x + 2,
+							  (y + 1) * GRID_SIZE + x + 1};
+			if (y % 2 == 1)
+				for (int& corner: corners)
+					corner -= count + 1;
+			auto writeCorner = [&](int corner) { file << ' ' << corner << '/' << corner << '/' << corner; };
+			if ((x + y) % 7 == 0)
+			{
+				file << 'f';
+				writeCorner(corners[0]);
+				writeCorner(corners[1]);
+				writeCorner(corners[2]);
+				file << "\nf";
+				writeCorner(corners[0]);
+				writeCorner(corners[2]);
+				writeCorner(corners[3]);
+			}
+			else
+			{
+				file << 'f';
+				for (int corner: corners)
+					writeCorner(corner);
+			}
+			file << '\n';
+		}
+	}
+}
+
+bool isSame(const Vertices& a, const Vertices& b)
+{
+	return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(Vertex)) == 0;
+}
+
+int main(int argc, char** argv)
+{
+	std::string fileName;
+	bool generated = argc < 2;
+	if (generated)
+	{
+		fileName = (std::filesystem::temp_directory_path() / "ObjParserBenchmark.obj").string();
+		writeObj(fileName);
+	}
+	else
+		fileName = argv[1];
+	const double megabytes = static_cast<double>(std::filesystem::file_size(fileName)) / (1024.0 * 1024.0);
+	std::cout << "ObjParser: " << fileName << ", " << megabytes << " MB" << std::endl;
+
+	Vertices reference;
+	auto start = std::chrono::steady_clock::now();
+	if (!ObjParser::parseWithTinyObj(fileName, std::filesystem::path(fileName).parent_path().string(), reference))
+	{
+		std::cerr << "tinyobj failed to read " << fileName << std::endl;
+		return 1;
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	std::cout << "tinyobj: " << megabytes / elapsed.count() << " MB/s, " << reference.size() << " vertices"
+			  << std::endl;
+
+	int result = 0;
+	const std::size_t maxThreadCount = std::max(1u, std::thread::hardware_concurrency());
+	for (std::size_t threadCount = 1; threadCount <= maxThreadCount;
+		 threadCount = threadCount == maxThreadCount ? threadCount + 1 : std::min(threadCount * 2, maxThreadCount))
+	{
+		ObjParser parser(threadCount);
+		double throughput = 0.0;
+		for (int i = 0; i < ITERATIONS; ++i)
+		{
+			Vertices vertices;
+			ObjParser::Result parseResult = parser.parse(fileName, vertices);
+			if (parseResult == ObjParser::Result::Unsupported)
+			{
+				std::cerr << "ObjParser: the file has polygons with more than 4 vertices" << std::endl;
+				return 1;
+			}
+			if (parseResult != ObjParser::Result::Success || !isSame(vertices, reference))
+			{
+				std::cerr << "ObjParser (" << threadCount << " threads) disagrees with tinyobj" << std::endl;
+				result = 1;
+				break;
+			}
+			throughput = std::max(throughput, parser.getThroughput());
+		}
+		std::cout << threadCount << " threads: " << throughput << " MB/s" << std::endl;
+	}
+
+	if (generated)
+		std::filesystem::remove(fileName);
+	return result;
+}
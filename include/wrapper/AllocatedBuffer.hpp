@@ -6,8 +6,10 @@
 #define CONCERTOGRAPHICS_ALLOCATEDBUFFER_HPP
 
 #include <vulkan/vulkan.h>
+#include <cassert>
 #include <cstddef>
 #include <iostream>
+#include <span>
 #include "Allocator.hpp"
 #include "vk_mem_alloc.h"
 
@@ -16,10 +18,16 @@ namespace Concerto::Graphics::Wrapper
 	class AllocatedBuffer
 	{
 	public:
+		/**
+		 * @param allocationFlags VMA_ALLOCATION_CREATE_MAPPED_BIT keeps host visible memory mapped for the whole
+		 * life of the buffer, see getMappedData()
+		 *
+		 * GPU_ONLY buffers get both transfer usages so a Defragmenter can copy them to their new place.
+		 */
 		AllocatedBuffer(Allocator& allocator, std::size_t allocSize,
-				VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage);
+				VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage, VmaAllocationCreateFlags allocationFlags = 0);
 
-		AllocatedBuffer(AllocatedBuffer&&) = default;
+		AllocatedBuffer(AllocatedBuffer&& other) noexcept;
 
 		AllocatedBuffer(const AllocatedBuffer&) = delete;
 
@@ -29,26 +37,63 @@ namespace Concerto::Graphics::Wrapper
 
 		~AllocatedBuffer();
 
+		/**
+		 * @return false if the buffer was not created with VMA_ALLOCATION_CREATE_MAPPED_BIT or its memory
+		 * is not host visible
+		 */
+		[[nodiscard]] bool isMapped() const;
+
+		/**
+		 * @brief View of the persistent mapping as elements of T, writes must be followed by flush()
+		 */
+		template<typename T = std::byte>
+		[[nodiscard]] std::span<T> getMappedData() const
+		{
+			assert(isMapped());
+			return { static_cast<T*>(_mappedData), _size / sizeof(T) };
+		}
+
+		/**
+		 * @brief Makes the host writes of [offset, offset + size) visible to the device, does nothing on
+		 * host coherent memory
+		 */
+		void flush(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE) const;
+
+		/**
+		 * @brief Makes the device writes of [offset, offset + size) visible to the host, does nothing on
+		 * host coherent memory
+		 */
+		void invalidate(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE) const;
+
+		[[nodiscard]] std::size_t getSize() const;
+
+		[[nodiscard]] VkBufferUsageFlags getUsage() const;
+
 		Allocator &_allocator;
 		VkBuffer _buffer {VK_NULL_HANDLE};
 		VmaAllocation _allocation {VK_NULL_HANDLE};
+	private:
+		std::size_t _size;
+		void* _mappedData;
+		VkBufferUsageFlags _usage;
+		MemoryTag _tag;
 	};
 
 	template<typename T>
 	AllocatedBuffer
 	makeAllocatedBuffer(Allocator& allocator, VkBufferUsageFlags usage,
-			VmaMemoryUsage memoryUsage)
+			VmaMemoryUsage memoryUsage, VmaAllocationCreateFlags allocationFlags = 0)
 	{
-		return { allocator, sizeof(T), usage, memoryUsage };
+		return { allocator, sizeof(T), usage, memoryUsage, allocationFlags };
 	}
 
 	template<typename T>
 	AllocatedBuffer
 	makeAllocatedBuffer(Allocator& allocator, std::size_t objNumber,
-			VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage)
+			VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage, VmaAllocationCreateFlags allocationFlags = 0)
 	{
-		return { allocator, sizeof(T) * objNumber, usage, memoryUsage };
+		return { allocator, sizeof(T) * objNumber, usage, memoryUsage, allocationFlags };
 	}
 
 } // Concerto::Graphics::Wrapper
-#endif //CONCERTOGRAPHICS_ALLOCATEDBUFFER_HPP
\ No newline at end of file
+#endif //CONCERTOGRAPHICS_ALLOCATEDBUFFER_HPP
@@ -4,18 +4,173 @@
 
 #ifndef CONCERTOGRAPHICS_ALLOCATOR_HPP
 #define CONCERTOGRAPHICS_ALLOCATOR_HPP
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
 #include "vulkan/vulkan.h"
 #include "vk_mem_alloc.h"
+#include "BufferPool.hpp"
 
 namespace Concerto::Graphics::Wrapper
 {
+	class Defragmenter;
+
+	/**
+	 * @brief Usage classes of the buffers sub-allocated by Allocator::allocateBuffer()
+	 */
+	enum class BufferUsage
+	{
+		Uniform, // CPU_TO_GPU and mapped, offsets aligned to minUniformBufferOffsetAlignment
+		Storage, // CPU_TO_GPU and mapped, offsets aligned to minStorageBufferOffsetAlignment
+		Geometry, // GPU_ONLY vertex and index data, filled through an UploadContext
+		Staging, // CPU_ONLY and mapped transfer source
+		Count
+	};
+
+	/**
+	 * @brief What the memory of an allocation is used for, for the statistics of Allocator
+	 */
+	enum class MemoryTag
+	{
+		Geometry,
+		Uniform,
+		Storage,
+		Staging,
+		Image,
+		Other,
+		Count
+	};
+
+	/**
+	 * @return The tag of a buffer created with usage, vertex and index usages first
+	 */
+	MemoryTag getMemoryTag(VkBufferUsageFlags usage);
+
+	const char* getMemoryTagName(MemoryTag tag);
+
+	struct MemoryHeapStatistics
+	{
+		VkDeviceSize size;
+		bool deviceLocal;
+		VkDeviceSize usage; // by this process, other processes included when VK_EXT_memory_budget is enabled
+		VkDeviceSize budget; // estimated as 80% of size without VK_EXT_memory_budget
+		VkDeviceSize blockBytes; // VkDeviceMemory allocated by VMA
+		VkDeviceSize allocationBytes; // part of blockBytes in use
+		std::uint32_t blockCount;
+		std::uint32_t allocationCount;
+	};
+
+	struct MemoryUsageStatistics
+	{
+		std::size_t allocationCount;
+		VkDeviceSize bytes;
+	};
+
+	struct MemoryStatistics
+	{
+		std::vector<MemoryHeapStatistics> heaps;
+		std::array<MemoryUsageStatistics, static_cast<std::size_t>(MemoryTag::Count)> tags; // requested sizes
+		std::array<MemoryUsageStatistics, static_cast<std::size_t>(BufferUsage::Count)> pools; // live PooledBuffers
+		std::uint32_t unusedRangeCount; // free ranges inside the VMA blocks
+		VkDeviceSize unusedBytes;
+		VkDeviceSize largestUnusedRange;
+		/**
+		 * @brief 1 - largestUnusedRange / unusedBytes, 0 when the free memory of the blocks is a single range and
+		 * close to 1 when it is scattered into many small ones
+		 */
+		float fragmentation;
+	};
+
 	class Allocator
 	{
 	public:
-		Allocator(VkPhysicalDevice physicalDevice, VkDevice device, VkInstance instance);
+		/**
+		 * @param memoryBudget VK_EXT_memory_budget is enabled on device, the heap budgets then come from the driver
+		 * instead of being estimated from the heap sizes
+		 */
+		Allocator(VkPhysicalDevice physicalDevice, VkDevice device, VkInstance instance, bool memoryBudget = false);
+
+		Allocator(Allocator&&) = delete;
+
+		Allocator(const Allocator&) = delete;
+
+		Allocator& operator=(Allocator&&) = delete;
+
+		Allocator& operator=(const Allocator&) = delete;
+
+		/**
+		 * @brief Every PooledBuffer must have been destroyed
+		 */
 		~Allocator();
 
+		/**
+		 * @brief Sub-allocates size bytes from the pool of usage instead of creating a buffer, for the small and
+		 * numerous buffers. Large ones should still be an AllocatedBuffer.
+		 */
+		PooledBuffer allocateBuffer(BufferUsage usage, VkDeviceSize size);
+
+		[[nodiscard]] BufferPool& getBufferPool(BufferUsage usage);
+
+		/**
+		 * @brief To call once per frame, VMA refreshes the budgets of VK_EXT_memory_budget on frame changes
+		 */
+		void setCurrentFrameIndex(std::uint32_t frameIndex);
+
+		/**
+		 * @brief Usage and budget of every heap, cheap enough to be called every frame
+		 */
+		[[nodiscard]] std::vector<MemoryHeapStatistics> getHeapBudgets() const;
+
+		/**
+		 * @brief Heap budgets, counts per tag and pool, and fragmentation. Walks every VMA block, not for every frame.
+		 */
+		[[nodiscard]] MemoryStatistics getStatistics() const;
+
+		/**
+		 * @brief JSON snapshot of the VMA state from vmaBuildStatsString()
+		 * @param detailedMap Lists every allocation and free range of every block
+		 */
+		[[nodiscard]] std::string buildStatsString(bool detailedMap = false) const;
+
+		/**
+		 * @brief Writes buildStatsString(detailedMap) to fileName
+		 * @return false if the file can not be written
+		 */
+		bool writeStatsFile(const std::string& fileName, bool detailedMap = true) const;
+
+		[[nodiscard]] bool hasMemoryBudget() const;
+
+		/**
+		 * @brief Counts an allocation of size bytes under tag, done by AllocatedBuffer for its buffers
+		 */
+		void trackAllocation(MemoryTag tag, VkDeviceSize size);
+
+		void untrackAllocation(MemoryTag tag, VkDeviceSize size);
+
+		/**
+		 * @brief vmaDestroyBuffer(), unless a Defragmenter is moving allocation: the memory is then released by
+		 * the end of its pass
+		 */
+		void destroyBuffer(VkBuffer buffer, VmaAllocation allocation);
+
 		VmaAllocator _allocator;
+	private:
+		friend class Defragmenter;
+
+		struct TagCounters
+		{
+			std::atomic<std::size_t> allocationCount;
+			std::atomic<VkDeviceSize> bytes;
+		};
+
+		bool _memoryBudget;
+		Defragmenter* _defragmenter;
+		std::array<TagCounters, static_cast<std::size_t>(MemoryTag::Count)> _tagCounters;
+		std::array<std::unique_ptr<BufferPool>, static_cast<std::size_t>(BufferUsage::Count)> _bufferPools;
 	};
 }
 
@@ -0,0 +1,66 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_BOUNDINGVOLUME_HPP
+#define CONCERTOGRAPHICS_BOUNDINGVOLUME_HPP
+
+#include <span>
+#include "glm/glm.hpp"
+#include "Vertex.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	struct BoundingBox
+	{
+		glm::vec3 min;
+		glm::vec3 max;
+	};
+
+	struct BoundingSphere
+	{
+		glm::vec3 center;
+		float radius;
+	};
+
+	/**
+	 * @brief Planes of a view frustum, xyz is the inward normal and w the distance, in the space of the matrix
+	 * they were extracted from
+	 */
+	struct Frustum
+	{
+		glm::vec4 planes[6];
+	};
+
+	BoundingBox computeBoundingBox(std::span<const Vertex> vertices);
+
+	/**
+	 * @brief Ritter's approximate bounding sphere, at most ~5% larger than the optimal one
+	 */
+	BoundingSphere computeBoundingSphere(std::span<const glm::vec3> positions);
+
+	BoundingSphere computeBoundingSphere(std::span<const Vertex> vertices);
+
+	/**
+	 * @brief Plain C++ versions of the kernels above, which use SSE2 or AVX2 when the build enables them.
+	 * Both versions return the same bounds.
+	 */
+	BoundingBox computeBoundingBoxScalar(std::span<const Vertex> vertices);
+
+	BoundingSphere computeBoundingSphereScalar(std::span<const glm::vec3> positions);
+
+	/**
+	 * @return "AVX2", "SSE2" or "Scalar", the instruction set computeBoundingBox() and computeBoundingSphere()
+	 * were built for
+	 */
+	const char* getBoundingVolumeKernelName();
+
+	/**
+	 * @brief Gribb-Hartmann plane extraction, expects a Vulkan [0, 1] depth range
+	 */
+	Frustum extractFrustum(const glm::mat4& viewProjection);
+
+	bool intersects(const Frustum& frustum, const BoundingSphere& sphere);
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_BOUNDINGVOLUME_HPP
\ No newline at end of file
@@ -0,0 +1,159 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_BUFFERPOOL_HPP
+#define CONCERTOGRAPHICS_BUFFERPOOL_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+#include "vulkan/vulkan.h"
+#include "vk_mem_alloc.h"
+
+namespace Concerto::Graphics::Wrapper
+{
+	class Allocator;
+	class BufferPool;
+
+	/**
+	 * @brief Range of a buffer shared with other allocations of a BufferPool, given back to the pool on destruction
+	 *
+	 * Descriptors and copies must use getBuffer() with getOffset(), the range never starts at 0 of the buffer.
+	 * getBuffer() is not to be cached across frames, a Defragmenter may replace the buffer of the pool block.
+	 */
+	class PooledBuffer
+	{
+	public:
+		PooledBuffer() = default;
+
+		PooledBuffer(PooledBuffer&& other) noexcept;
+
+		PooledBuffer(const PooledBuffer&) = delete;
+
+		PooledBuffer& operator=(PooledBuffer&& other) noexcept;
+
+		PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+		~PooledBuffer();
+
+		[[nodiscard]] bool isValid() const;
+
+		[[nodiscard]] VkBuffer getBuffer() const;
+
+		[[nodiscard]] VkDeviceSize getOffset() const;
+
+		[[nodiscard]] VkDeviceSize getSize() const;
+
+		/**
+		 * @return false if the pool memory is not host visible
+		 */
+		[[nodiscard]] bool isMapped() const;
+
+		/**
+		 * @brief View of the range in the persistent mapping of the pool, writes must be followed by flush()
+		 */
+		template<typename T = std::byte>
+		[[nodiscard]] std::span<T> getMappedData() const
+		{
+			assert(isMapped());
+			return { reinterpret_cast<T*>(_data), static_cast<std::size_t>(_size / sizeof(T)) };
+		}
+
+		/**
+		 * @brief Makes the host writes to the range visible to the device, does nothing on host coherent memory
+		 */
+		void flush() const;
+
+		/**
+		 * @brief Gives the range back to its pool, the buffer must not be in use by the device anymore
+		 */
+		void reset();
+
+	private:
+		friend class BufferPool;
+
+		BufferPool* _pool = nullptr;
+		void* _block = nullptr;
+		VkDeviceSize _offset = 0;
+		VkDeviceSize _size = 0;
+		std::byte* _data = nullptr;
+	};
+
+	/**
+	 * @brief Sub-allocates small buffers from a few large VkBuffers of the same usage
+	 *
+	 * Blocks of blockSize bytes are created on demand and their ranges handed out best fit by an OffsetAllocator,
+	 * so thousands of allocations only cost a handful of vmaCreateBuffer calls and device memory allocations.
+	 * A request larger than blockSize gets a block of its own. A block is destroyed when its last range is freed,
+	 * except the last block of the pool which is kept for the next allocations.
+	 */
+	class BufferPool
+	{
+	public:
+		/**
+		 * @param alignment Offset alignment of every range, minUniformBufferOffsetAlignment or
+		 * minStorageBufferOffsetAlignment when the ranges are bound as descriptors
+		 */
+		BufferPool(Allocator& allocator, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage,
+				VmaAllocationCreateFlags allocationFlags, VkDeviceSize blockSize, VkDeviceSize alignment);
+
+		BufferPool(BufferPool&&) = delete;
+
+		BufferPool(const BufferPool&) = delete;
+
+		BufferPool& operator=(BufferPool&&) = delete;
+
+		BufferPool& operator=(const BufferPool&) = delete;
+
+		/**
+		 * @brief Every PooledBuffer of the pool must have been destroyed
+		 */
+		~BufferPool();
+
+		PooledBuffer allocate(VkDeviceSize size);
+
+		[[nodiscard]] VkBufferUsageFlags getUsage() const;
+
+		[[nodiscard]] VkDeviceSize getAlignment() const;
+
+		[[nodiscard]] std::size_t getBlockCount() const;
+
+		[[nodiscard]] std::size_t getAllocationCount() const;
+
+		/**
+		 * @return The bytes handed out to the live PooledBuffers, alignment padding excluded
+		 */
+		[[nodiscard]] VkDeviceSize getUsedSize() const;
+
+		/**
+		 * @return The size of every block of the pool
+		 */
+		[[nodiscard]] VkDeviceSize getReservedSize() const;
+
+	private:
+		friend class PooledBuffer;
+
+		struct Block;
+
+		void free(const PooledBuffer& buffer);
+
+		void flush(const PooledBuffer& buffer) const;
+
+		Allocator& _allocator;
+		VkBufferUsageFlags _usage;
+		VmaMemoryUsage _memoryUsage;
+		VmaAllocationCreateFlags _allocationFlags;
+		VkDeviceSize _blockSize;
+		VkDeviceSize _alignment;
+		std::vector<std::unique_ptr<Block>> _blocks;
+		std::size_t _allocationCount;
+		VkDeviceSize _usedSize;
+		mutable std::mutex _mutex;
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_BUFFERPOOL_HPP
@@ -0,0 +1,76 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_COMMANDALLOCATOR_HPP
+#define CONCERTOGRAPHICS_COMMANDALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "vulkan/vulkan.h"
+#include "CommandBuffer.hpp"
+#include "CommandPool.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief Hands out the command buffers of one frame from a transient CommandPool
+	 *
+	 * The command buffers are allocated the first time they are needed and recycled afterwards: reset() resets the
+	 * whole pool with a single vkResetCommandPool and puts every command buffer back in the free lists, instead of
+	 * resetting each of them. The command buffers must not be reset one by one. Not thread safe, every recording
+	 * thread needs its own CommandAllocator.
+	 */
+	class CommandAllocator
+	{
+	public:
+		CommandAllocator(VkDevice device, std::uint32_t queueFamily);
+
+		CommandAllocator(CommandAllocator&&) = delete;
+
+		CommandAllocator(const CommandAllocator&) = delete;
+
+		CommandAllocator& operator=(CommandAllocator&&) = delete;
+
+		CommandAllocator& operator=(const CommandAllocator&) = delete;
+
+		~CommandAllocator() = default;
+
+		/**
+		 * @brief Returns a command buffer in the initial state, valid until the next reset()
+		 */
+		CommandBuffer& allocate(VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+		/**
+		 * @brief To call once the fence of the last submission using the command buffers has signaled
+		 */
+		void reset();
+
+		/**
+		 * @return The number of command buffers handed out since the last reset()
+		 */
+		[[nodiscard]] std::size_t getUsedCount() const;
+
+		/**
+		 * @return The number of command buffers allocated from the pool
+		 */
+		[[nodiscard]] std::size_t getCapacity() const;
+
+	private:
+		struct FreeList
+		{
+			std::vector<std::unique_ptr<CommandBuffer>> commandBuffers;
+			std::size_t usedCount = 0;
+		};
+
+		VkDevice _device;
+		CommandPool _commandPool;
+		// Declared after the pool, the command buffers are freed before it
+		FreeList _primary;
+		FreeList _secondary;
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_COMMANDALLOCATOR_HPP
@@ -5,6 +5,10 @@
 #ifndef CONCERTOGRAPHICS_COMMANDBUFFER_HPP
 #define CONCERTOGRAPHICS_COMMANDBUFFER_HPP
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include "vulkan/vulkan.h"
 #include "Pipeline.hpp"
 #include "AllocatedBuffer.hpp"
@@ -13,10 +17,44 @@
 
 namespace Concerto::Graphics::Wrapper
 {
+	/**
+	 * @brief Commands setting a state of the command buffer, which CommandBuffer drops when the state is already set
+	 */
+	enum class StateCommand
+	{
+		Pipeline,
+		DescriptorSets,
+		VertexBuffers,
+		IndexBuffer,
+		PushConstants,
+		Count
+	};
+
+	const char* getStateCommandName(StateCommand command);
+
+	struct StateCommandCounters
+	{
+		std::uint32_t issued;
+		std::uint32_t elided; // dropped because they would set the state already set
+	};
+
+	using StateStatistics = std::array<StateCommandCounters, static_cast<std::size_t>(StateCommand::Count)>;
+
+	void addStateStatistics(StateStatistics& total, const StateStatistics& statistics);
+
+	/**
+	 * @brief Records the bound pipelines, descriptor sets with their dynamic offsets, vertex and index buffers and
+	 * push constants, and drops the commands setting them to what they already are
+	 *
+	 * The recorded state is forgotten by begin(), reset() and executeCommands(), after which the next command of
+	 * each kind is always issued. Descriptor sets bound with a pipeline layout are only assumed to stay bound by
+	 * later binds with the same layout, and push constants by pushes with the same layout.
+	 */
 	class CommandBuffer
 	{
 	public:
-		explicit CommandBuffer(VkDevice device, VkCommandPool commandPool);
+		explicit CommandBuffer(VkDevice device, VkCommandPool commandPool,
+				VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 
 		CommandBuffer(CommandBuffer&&) = default;
 
@@ -34,9 +72,18 @@ namespace Concerto::Graphics::Wrapper
 
 		void begin();
 
+		/**
+		 * @brief Begins a secondary command buffer recording inside the render pass and subpass of inheritanceInfo
+		 */
+		void begin(const VkCommandBufferInheritanceInfo& inheritanceInfo);
+
 		void end();
 
-		void beginRenderPass(VkRenderPassBeginInfo info);
+		/**
+		 * @param contents VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS if the subpass is recorded with
+		 * executeCommands(), it can then hold no other command
+		 */
+		void beginRenderPass(VkRenderPassBeginInfo info, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
 
 		void endRenderPass();
 
@@ -44,25 +91,140 @@ namespace Concerto::Graphics::Wrapper
 
 		void bindPipeline(VkPipelineBindPoint pipelineBindPoint, VkPipeline pipeline);
 
+		/**
+		 * @param descriptorSetCount Must be 1, descriptorSet is bound at firstSet
+		 */
 		void bindDescriptorSets(VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout pipelineLayout,
 				std::uint32_t firstSet, std::uint32_t descriptorSetCount, DescriptorSet& descriptorSet,
 				std::uint32_t dynamicOffsets);
 		void bindDescriptorSets(VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout pipelineLayout,
 				std::uint32_t firstSet, std::uint32_t descriptorSetCount, DescriptorSet& descriptorSet);
 
+		/**
+		 * @param dynamicOffsets One offset per dynamic binding of descriptorSet, in binding order
+		 */
+		void bindDescriptorSets(VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout pipelineLayout,
+				std::uint32_t firstSet, std::uint32_t descriptorSetCount, DescriptorSet& descriptorSet,
+				std::span<const std::uint32_t> dynamicOffsets);
+
 		void bindVertexBuffers(const AllocatedBuffer& buffer);
 
+		/**
+		 * @brief Binds buffers[i] at offsets[i] to the binding firstBinding + i
+		 */
+		void bindVertexBuffers(std::uint32_t firstBinding, std::span<const VkBuffer> buffers,
+				std::span<const VkDeviceSize> offsets);
+
+		void bindIndexBuffer(const AllocatedBuffer& buffer, VkIndexType indexType = VK_INDEX_TYPE_UINT32);
+
+		void bindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType = VK_INDEX_TYPE_UINT32);
+
 		void updatePushConstants(PipelineLayout& pipelineLayout, MeshPushConstants& meshPushConstants);
 
 		void updatePushConstants(VkPipelineLayout pipelineLayout, MeshPushConstants& meshPushConstants);
 
+		/**
+		 * @brief Writes size bytes of data at offset in the push constants of stageFlags
+		 */
+		void pushConstants(VkPipelineLayout pipelineLayout, VkShaderStageFlags stageFlags, const void* data,
+				std::uint32_t size, std::uint32_t offset = 0);
+
 		void draw(std::uint32_t vertexCount, std::uint32_t instanceCount, std::uint32_t firstVertex,
 				std::uint32_t firstInstance);
 
+		void drawIndexed(std::uint32_t indexCount, std::uint32_t instanceCount, std::uint32_t firstIndex,
+				std::int32_t vertexOffset, std::uint32_t firstInstance);
+
+		/**
+		 * @brief Executes secondary command buffers, in order
+		 */
+		void executeCommands(std::span<const VkCommandBuffer> commandBuffers);
+
+		/**
+		 * @brief Draws drawCount VkDrawIndexedIndirectCommand read from buffer at offset, more than one needs the
+		 * multiDrawIndirect feature
+		 */
+		void drawIndexedIndirect(VkBuffer buffer, VkDeviceSize offset, std::uint32_t drawCount,
+				std::uint32_t stride = sizeof(VkDrawIndexedIndirectCommand));
+
+		/**
+		 * @brief Draws the first min(count, maxDrawCount) commands of buffer at offset, count being the uint32_t
+		 * read from countBuffer at countOffset when the draw executes. Needs VK_KHR_draw_indirect_count.
+		 * @throw std::runtime_error if the device does not expose vkCmdDrawIndexedIndirectCountKHR
+		 */
+		void drawIndexedIndirectCount(VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer,
+				VkDeviceSize countOffset, std::uint32_t maxDrawCount,
+				std::uint32_t stride = sizeof(VkDrawIndexedIndirectCommand));
+
+		void dispatch(std::uint32_t groupCountX, std::uint32_t groupCountY = 1, std::uint32_t groupCountZ = 1);
+
+		/**
+		 * @brief Fills [offset, offset + size) of buffer with the 4 bytes of data, outside of a render pass
+		 */
+		void fillBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size, std::uint32_t data);
+
+		void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, std::span<const VkBufferCopy> regions);
+
+		/**
+		 * @brief Global memory barrier, also orders the commands of the later submissions to the same queue
+		 */
+		void memoryBarrier(VkPipelineStageFlags srcStageMask, VkAccessFlags srcAccessMask,
+				VkPipelineStageFlags dstStageMask, VkAccessFlags dstAccessMask);
+
+		[[nodiscard]] VkCommandBufferLevel getLevel() const;
+
+		/**
+		 * @brief Counters of the state commands since the last begin()
+		 */
+		[[nodiscard]] const StateStatistics& getStateStatistics() const;
+
+		/**
+		 * @brief Forgets the recorded state, the next state commands are all issued
+		 */
+		void invalidateState();
+
 	private:
+		static constexpr std::size_t BindPointCount = 2; // graphics and compute
+		static constexpr std::size_t MaxTrackedDescriptorSets = 8;
+		static constexpr std::size_t MaxTrackedDynamicOffsets = 8;
+		static constexpr std::size_t MaxTrackedVertexBindings = 16;
+		static constexpr std::size_t MaxTrackedPushConstantSize = 256;
+
+		// VK_NULL_HANDLE where the state is unknown
+		struct BoundDescriptorSet
+		{
+			VkPipelineLayout pipelineLayout;
+			VkDescriptorSet descriptorSet;
+			std::uint32_t dynamicOffsetCount;
+			std::array<std::uint32_t, MaxTrackedDynamicOffsets> dynamicOffsets;
+		};
+
+		struct BoundState
+		{
+			std::array<VkPipeline, BindPointCount> pipelines;
+			std::array<std::array<BoundDescriptorSet, MaxTrackedDescriptorSets>, BindPointCount> descriptorSets;
+			std::array<VkBuffer, MaxTrackedVertexBindings> vertexBuffers;
+			std::array<VkDeviceSize, MaxTrackedVertexBindings> vertexBufferOffsets;
+			VkBuffer indexBuffer;
+			VkDeviceSize indexBufferOffset;
+			VkIndexType indexType;
+			VkPipelineLayout pushConstantLayout;
+			std::array<std::byte, MaxTrackedPushConstantSize> pushConstants;
+			std::array<VkShaderStageFlags, MaxTrackedPushConstantSize> pushConstantStages; // 0 if the byte is unknown
+		};
+
+		void bindDescriptorSet(VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout pipelineLayout,
+				std::uint32_t set, VkDescriptorSet descriptorSet, std::span<const std::uint32_t> dynamicOffsets);
+
+		void count(StateCommand command, bool elided);
+
 		VkDevice _device;
 		VkCommandPool _commandPool;
 		VkCommandBuffer _commandBuffer;
+		VkCommandBufferLevel _level;
+		PFN_vkCmdDrawIndexedIndirectCountKHR _drawIndexedIndirectCount; // loaded on first use
+		BoundState _state;
+		StateStatistics _stateStatistics;
 	};
 } // namespace Concerto::Graphics::Wrapper
 
@@ -11,7 +11,12 @@ namespace Concerto::Graphics::Wrapper
 	class CommandPool
 	{
 	public:
-		CommandPool(VkDevice device, std::uint32_t queueFamily);
+		/**
+		 * @param flags VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT lets the command buffers be reset one by one,
+		 * pools without it are only reset whole with reset()
+		 */
+		CommandPool(VkDevice device, std::uint32_t queueFamily,
+				VkCommandPoolCreateFlags flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
 
 		CommandPool(CommandPool&&) = default;
 
@@ -23,6 +28,11 @@ namespace Concerto::Graphics::Wrapper
 
 		~CommandPool();
 		VkCommandPool get() const;
+
+		/**
+		 * @brief Resets every command buffer of the pool, none may be in use by the device
+		 */
+		void reset();
 	private:
 		VkDevice _device;
 		VkCommandPool _commandPool;
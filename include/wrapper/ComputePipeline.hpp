@@ -0,0 +1,45 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_COMPUTEPIPELINE_HPP
+#define CONCERTOGRAPHICS_COMPUTEPIPELINE_HPP
+
+#include "vulkan/vulkan.h"
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief Pipeline made of a single compute shader, bound at VK_PIPELINE_BIND_POINT_COMPUTE
+	 */
+	class ComputePipeline
+	{
+	public:
+		/**
+		 * @param shaderModule Compute shader, its entry point must be main
+		 * @throw std::runtime_error if the pipeline cannot be created
+		 */
+		ComputePipeline(VkDevice device, VkPipelineLayout pipelineLayout, VkShaderModule shaderModule);
+
+		ComputePipeline(ComputePipeline&&) = delete;
+
+		ComputePipeline(const ComputePipeline&) = delete;
+
+		ComputePipeline& operator=(ComputePipeline&&) = delete;
+
+		ComputePipeline& operator=(const ComputePipeline&) = delete;
+
+		~ComputePipeline();
+
+		[[nodiscard]] VkPipeline get() const;
+
+		[[nodiscard]] VkPipelineLayout getPipelineLayout() const;
+
+	private:
+		VkDevice _device;
+		VkPipelineLayout _pipelineLayout;
+		VkPipeline _pipeline;
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_COMPUTEPIPELINE_HPP
@@ -0,0 +1,113 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_DEFRAGMENTER_HPP
+#define CONCERTOGRAPHICS_DEFRAGMENTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "vulkan/vulkan.h"
+#include "vk_mem_alloc.h"
+#include "Allocator.hpp"
+#include "CommandBuffer.hpp"
+#include "DeletionQueue.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief Compacts the VMA blocks of an Allocator a few allocations per frame
+	 *
+	 * Each pass moves at most maxBytesPerPass bytes: the copies are recorded in the frame command buffer and the
+	 * AllocatedBuffers moved are patched right away to their new VkBuffer, so the rest of the frame already reads
+	 * them from their new place. The old buffers go to the DeletionQueue and the pass ends, releasing the old
+	 * memory, once the queue reaches them, when every frame that could still use them is done. Only unmapped buffers are moved, the host keeps writing to the
+	 * mapped ones at any time.
+	 */
+	class Defragmenter
+	{
+	public:
+		struct Statistics
+		{
+			VkDeviceSize bytesMoved;
+			VkDeviceSize bytesFreed;
+			std::uint32_t allocationsMoved;
+			std::uint32_t blocksFreed;
+			std::size_t passCount;
+			double time; // CPU seconds spent in update()
+		};
+
+		/**
+		 * @param deletionQueue Queue of the frames in flight, retires the buffers replaced by the moves
+		 */
+		Defragmenter(Allocator& allocator, DeletionQueue& deletionQueue,
+				VkDeviceSize maxBytesPerPass = 16 * 1024 * 1024, std::uint32_t maxAllocationsPerPass = 64);
+
+		Defragmenter(Defragmenter&&) = delete;
+
+		Defragmenter(const Defragmenter&) = delete;
+
+		Defragmenter& operator=(Defragmenter&&) = delete;
+
+		Defragmenter& operator=(const Defragmenter&) = delete;
+
+		/**
+		 * @brief Ends the current defragmentation, the device must be idle
+		 */
+		~Defragmenter();
+
+		/**
+		 * @brief Starts a defragmentation, does nothing if one is already running
+		 */
+		void start();
+
+		/**
+		 * @brief To call once per frame from the render thread, after DeletionQueue::beginFrame() and before
+		 * recording the commands using the buffers. Copies are recorded in commandBuffer outside of a render pass,
+		 * behind a barrier making them visible to every later command of the queue.
+		 * @return true when the defragmentation finished in this call, see getStatistics()
+		 */
+		bool update(CommandBuffer& commandBuffer);
+
+		[[nodiscard]] bool isRunning() const;
+
+		/**
+		 * @return The statistics of the last defragmentation, or of the current one so far
+		 */
+		[[nodiscard]] const Statistics& getStatistics() const;
+
+	private:
+		friend class Allocator;
+
+		/**
+		 * @brief Drops the move of allocation from the current pass because its buffer is being destroyed
+		 * @return true if the memory of allocation is released by the pass and must not be freed
+		 */
+		bool abandon(VmaAllocation allocation);
+
+		/**
+		 * @return true if there was nothing left to move
+		 */
+		bool beginPass(CommandBuffer& commandBuffer);
+
+		/**
+		 * @return true if the defragmentation is complete
+		 */
+		bool endPass();
+
+		void finish();
+
+		Allocator& _allocator;
+		DeletionQueue& _deletionQueue;
+		VkDeviceSize _maxBytesPerPass;
+		std::uint32_t _maxAllocationsPerPass;
+		VmaDefragmentationContext _context;
+		VmaDefragmentationPassMoveInfo _pass;
+		bool _passPending;
+		std::shared_ptr<bool> _passExpired; // set by the DeletionQueue, which may outlive the Defragmenter
+		Statistics _statistics;
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_DEFRAGMENTER_HPP
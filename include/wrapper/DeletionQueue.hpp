@@ -0,0 +1,125 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_DELETIONQUEUE_HPP
+#define CONCERTOGRAPHICS_DELETIONQUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief Delays the destruction of GPU resources until no frame in flight can use them anymore
+	 *
+	 * Anything retired while frame N is being recorded is destroyed by the beginFrame() of frame N + frameCount,
+	 * which comes after the fence of frame N has been waited on. retire() takes ownership of a whole object, a
+	 * std::unique_ptr<Mesh> or an AllocatedBuffer, so its buffers, arena ranges and descriptors all go together;
+	 * push() defers a call for the raw Vulkan handles.
+	 */
+	class DeletionQueue
+	{
+	public:
+		/**
+		 * @param frameCount Number of frames in flight
+		 */
+		explicit DeletionQueue(std::size_t frameCount);
+
+		DeletionQueue(DeletionQueue&&) = delete;
+
+		DeletionQueue(const DeletionQueue&) = delete;
+
+		DeletionQueue& operator=(DeletionQueue&&) = delete;
+
+		DeletionQueue& operator=(const DeletionQueue&) = delete;
+
+		/**
+		 * @brief Destroys everything still queued, the device must be idle
+		 */
+		~DeletionQueue();
+
+		/**
+		 * @brief Takes object and destroys it once the frames recorded so far are done
+		 */
+		template<typename T>
+		void retire(T&& object)
+		{
+			static_assert(!std::is_lvalue_reference_v<T>, "retire() takes ownership, std::move the object");
+			enqueue(std::make_unique<RetiredObject<T>>(std::move(object)));
+		}
+
+		/**
+		 * @brief Calls deleter once the frames recorded so far are done
+		 */
+		template<typename F>
+		void push(F&& deleter)
+		{
+			enqueue(std::make_unique<RetiredCall<std::decay_t<F>>>(std::forward<F>(deleter)));
+		}
+
+		/**
+		 * @brief To call once per frame after waiting for the fence of the frame, destroys what the frame it
+		 * replaces retired
+		 */
+		void beginFrame();
+
+		/**
+		 * @brief Destroys everything now, the device must be idle
+		 */
+		void flush();
+
+		[[nodiscard]] std::size_t getPendingCount() const;
+
+	private:
+		struct Retired
+		{
+			virtual ~Retired() = default;
+		};
+
+		template<typename T>
+		struct RetiredObject final : Retired
+		{
+			explicit RetiredObject(T&& object) : object(std::move(object))
+			{
+			}
+
+			T object;
+		};
+
+		template<typename F>
+		struct RetiredCall final : Retired
+		{
+			explicit RetiredCall(F call) : call(std::move(call))
+			{
+			}
+
+			~RetiredCall() override
+			{
+				call();
+			}
+
+			F call;
+		};
+
+		struct Entry
+		{
+			std::uint64_t frame;
+			std::unique_ptr<Retired> retired;
+		};
+
+		void enqueue(std::unique_ptr<Retired> retired);
+
+		std::size_t _frameCount;
+		std::uint64_t _frame;
+		std::deque<Entry> _entries;
+		mutable std::mutex _mutex;
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_DELETIONQUEUE_HPP
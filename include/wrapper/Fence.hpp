@@ -26,6 +26,7 @@ namespace Concerto::Graphics::Wrapper
 		VkFence get() const;
 		void wait(std::uint64_t timeout);
 		void reset();
+		[[nodiscard]] bool isSignaled() const;
 
 
 	private:
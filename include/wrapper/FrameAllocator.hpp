@@ -0,0 +1,109 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_FRAMEALLOCATOR_HPP
+#define CONCERTOGRAPHICS_FRAMEALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "vulkan/vulkan.h"
+#include "Allocator.hpp"
+#include "AllocatedBuffer.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	struct FrameAllocation
+	{
+		VkBuffer buffer;
+		std::uint32_t offset; // to pass as the dynamic offset of the descriptor
+		void* data;
+
+		template<typename T>
+		[[nodiscard]] std::span<T> as(std::size_t count = 1) const
+		{
+			return { static_cast<T*>(data), count };
+		}
+	};
+
+	/**
+	 * @brief Ring of transient uniform, storage and indirect data, written once by the host and read by a single frame
+	 *
+	 * Allocations are bumped in one persistently mapped CPU_TO_GPU buffer, aligned on the device offset
+	 * alignments so they can be bound with dynamic descriptors. Everything a frame allocated is reclaimed by
+	 * beginFrame() the next time its frame index comes back, after the fence of that frame has been waited on.
+	 */
+	class FrameAllocator
+	{
+	public:
+		/**
+		 * @param size Capacity of the ring, shared by all the frames in flight
+		 * @param maxDescriptorRange Largest range of the dynamic descriptors bound on this buffer. The buffer is
+		 * made that much larger than the ring so any allocation can be bound with such a descriptor.
+		 */
+		FrameAllocator(Allocator& allocator, const VkPhysicalDeviceLimits& limits, std::size_t frameCount,
+				std::size_t size, std::size_t maxDescriptorRange);
+
+		FrameAllocator(FrameAllocator&&) = delete;
+
+		FrameAllocator(const FrameAllocator&) = delete;
+
+		FrameAllocator& operator=(FrameAllocator&&) = delete;
+
+		FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+		~FrameAllocator() = default;
+
+		/**
+		 * @brief Gives back the allocations of the previous frame recorded with frameIndex and starts a new one,
+		 * to call once the fence of that frame is signaled
+		 */
+		void beginFrame(std::size_t frameIndex);
+
+		/**
+		 * @brief Allocates size bytes aligned on minUniformBufferOffsetAlignment
+		 * @throw std::runtime_error if the frames in flight already use the whole ring
+		 */
+		FrameAllocation allocateUniform(std::size_t size);
+
+		/**
+		 * @brief Allocates size bytes aligned on minStorageBufferOffsetAlignment
+		 */
+		FrameAllocation allocateStorage(std::size_t size);
+
+		/**
+		 * @brief Allocates size bytes for VkDrawIndexedIndirectCommand or VkDrawIndirectCommand arrays
+		 */
+		FrameAllocation allocateIndirect(std::size_t size);
+
+		FrameAllocation allocate(std::size_t size, std::size_t alignment);
+
+		/**
+		 * @brief Makes the writes of the current frame visible to the device, to call before its submission
+		 */
+		void flush() const;
+
+		[[nodiscard]] VkBuffer getBuffer() const;
+
+		/**
+		 * @return The bytes held by the frames in flight, alignment and skipped ring ends included
+		 */
+		[[nodiscard]] std::size_t getUsedSize() const;
+
+	private:
+		AllocatedBuffer _buffer;
+		std::byte* _data;
+		std::size_t _size;
+		std::size_t _uniformAlignment;
+		std::size_t _storageAlignment;
+		std::vector<std::size_t> _frameUsed;
+		std::size_t _currentFrame;
+		std::size_t _frameStart;
+		std::size_t _head;
+		std::size_t _used;
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_FRAMEALLOCATOR_HPP
@@ -0,0 +1,97 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_GEOMETRYARENA_HPP
+#define CONCERTOGRAPHICS_GEOMETRYARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include "vulkan/vulkan.h"
+#include "AllocatedBuffer.hpp"
+#include "Allocator.hpp"
+#include "CommandBuffer.hpp"
+#include "OffsetAllocator.hpp"
+#include "UploadContext.hpp"
+#include "Vertex.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief One vertex buffer and one index buffer shared by every mesh of a VertexFormat
+	 *
+	 * Vertices and indices are sub-allocated in elements, not bytes, so a mesh is drawn with its first
+	 * vertex as vertexOffset and its first index added to firstIndex. The whole arena stays bound across
+	 * meshes. For VertexFormat::Split the vertex buffer holds all the positions, then all the attributes,
+	 * and a mesh uses the same element offset in both streams.
+	 */
+	class GeometryArena
+	{
+	public:
+		struct Range
+		{
+			std::uint32_t offset;
+			std::uint32_t count;
+		};
+
+		GeometryArena(Allocator& allocator, VertexFormat vertexFormat, std::uint32_t vertexCapacity,
+				std::uint32_t indexCapacity);
+
+		GeometryArena(GeometryArena&&) = delete;
+
+		GeometryArena(const GeometryArena&) = delete;
+
+		GeometryArena& operator=(GeometryArena&&) = delete;
+
+		GeometryArena& operator=(const GeometryArena&) = delete;
+
+		~GeometryArena() = default;
+
+		/**
+		 * @return std::nullopt if there is no free range of count vertices
+		 */
+		std::optional<Range> allocateVertices(std::uint32_t count);
+
+		std::optional<Range> allocateIndices(std::uint32_t count);
+
+		void freeVertices(const Range& range);
+
+		void freeIndices(const Range& range);
+
+		/**
+		 * @brief Uploads range.count vertices encoded in the arena VertexFormat, split ones being all the positions
+		 * followed by all the attributes
+		 */
+		void uploadVertices(UploadContext& uploadContext, const Range& range, std::span<const std::byte> data);
+
+		void uploadIndices(UploadContext& uploadContext, const Range& range, std::span<const std::uint32_t> indices);
+
+		/**
+		 * @brief Binds every vertex stream and the index buffer
+		 */
+		void bind(CommandBuffer& commandBuffer) const;
+
+		/**
+		 * @brief Binds the positions stream alone at binding 0 and the index buffer, for depth-only pipelines
+		 */
+		void bindPositions(CommandBuffer& commandBuffer) const;
+
+		[[nodiscard]] VertexFormat getVertexFormat() const;
+
+		[[nodiscard]] std::uint32_t getFreeVertexCount() const;
+
+		[[nodiscard]] std::uint32_t getFreeIndexCount() const;
+
+	private:
+		VertexFormat _vertexFormat;
+		std::uint32_t _vertexCapacity;
+		OffsetAllocator _vertexAllocator;
+		OffsetAllocator _indexAllocator;
+		AllocatedBuffer _vertexBuffer;
+		AllocatedBuffer _indexBuffer;
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_GEOMETRYARENA_HPP
@@ -0,0 +1,121 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_GLTFPARSER_HPP
+#define CONCERTOGRAPHICS_GLTFPARSER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+#include "glm/glm.hpp"
+#include "BoundingVolume.hpp"
+#include "MappedFile.hpp"
+#include "Vertex.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief glTF 2.0 binary (GLB) geometry parser
+	 *
+	 * The file is mapped and only its JSON chunk is parsed by parse(). The accessors keep pointing into the
+	 * mapped binary chunk, the read*() functions copy them straight into the caller's buffers, with a single
+	 * memcpy per primitive when an accessor is already laid out like the destination. Every triangle primitive
+	 * of the meshes instanced by the default scene is merged into one vertex and one index list, with its node
+	 * transform applied. Buffers stored outside of the GLB and sparse accessors are reported as Unsupported.
+	 */
+	class GltfParser
+	{
+	public:
+		enum class Result
+		{
+			Success,
+			Unsupported,
+			Error
+		};
+
+		Result parse(const std::string& fileName);
+
+		[[nodiscard]] std::size_t getVertexCount() const;
+
+		[[nodiscard]] std::size_t getIndexCount() const;
+
+		/**
+		 * @brief Bounds of the merged vertices, from the POSITION accessors min and max
+		 */
+		[[nodiscard]] BoundingBox getBoundingBox() const;
+
+		void readVertices(std::span<Vertex> vertices) const;
+
+		/**
+		 * @brief Reads the two streams of VertexFormat::Split
+		 */
+		void readVertices(std::span<glm::vec3> positions, std::span<VertexAttributes> attributes) const;
+
+		/**
+		 * @brief Reads the indices of every primitive, rebased on the first vertex of the primitive
+		 */
+		void readIndices(std::span<std::uint32_t> indices) const;
+
+		[[nodiscard]] std::size_t getPrimitiveCount() const;
+
+		/**
+		 * @return The size in bytes of the last parsed file
+		 */
+		[[nodiscard]] std::size_t getParsedBytes() const;
+
+		/**
+		 * @return The duration of the last parse in seconds
+		 */
+		[[nodiscard]] double getParseTime() const;
+
+		struct Accessor
+		{
+			const std::byte* data;
+			std::size_t count;
+			std::size_t stride;
+			std::uint32_t componentType;
+			std::uint32_t componentCount;
+			bool normalized;
+		};
+
+	private:
+		struct Primitive
+		{
+			Accessor positions;
+			std::optional<Accessor> normals;
+			std::optional<Accessor> colors;
+			std::optional<Accessor> uvs;
+			std::optional<Accessor> indices;
+			BoundingBox boundingBox;
+		};
+
+		struct Instance
+		{
+			std::size_t primitive;
+			glm::mat4 transform;
+			bool identity;
+		};
+
+		/**
+		 * @brief Writes the positions every stride bytes from out
+		 */
+		void readPositions(std::byte* out, std::size_t stride) const;
+
+		template<typename Write>
+		void readAttributes(Write&& write) const;
+
+		MappedFile _file;
+		std::vector<Primitive> _primitives;
+		std::vector<Instance> _instances;
+		std::size_t _vertexCount = 0;
+		std::size_t _indexCount = 0;
+		std::size_t _parsedBytes = 0;
+		double _parseTime = 0.0;
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_GLTFPARSER_HPP
@@ -0,0 +1,114 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_HOSTALLOCATOR_HPP
+#define CONCERTOGRAPHICS_HOSTALLOCATOR_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "vulkan/vulkan.h"
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief The VkAllocationCallbacks given to the driver, counting its host allocations per allocation scope
+	 *
+	 * Command and object scope allocations, the short lived ones made while creating a pipeline or recording, are
+	 * bumped from a block of the calling thread instead of going through malloc. A block is rewound as soon as
+	 * every allocation made from it is freed and given back once its thread moved to another one. Cache, device
+	 * and instance scope allocations, and any allocation larger than a quarter of a block, go to malloc.
+	 *
+	 * Constructing a HostAllocator installs it: from then on the wrappers pass getCallbacks() to every vkCreate and
+	 * vkDestroy call. It has to be constructed before the instance and destroyed after the last Vulkan object, the
+	 * same callbacks must be given when destroying an object as when creating it. Without a HostAllocator,
+	 * getCallbacks() returns nullptr and the driver uses its own allocator.
+	 */
+	class HostAllocator
+	{
+	public:
+		static constexpr std::size_t ScopeCount = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1;
+
+		struct ScopeStatistics
+		{
+			std::uint64_t allocationCount;
+			std::uint64_t reallocationCount;
+			std::uint64_t freeCount;
+			std::uint64_t arenaAllocationCount; // allocations and reallocations served by a thread block
+			std::uint64_t bytes; // live bytes
+			std::uint64_t peakBytes;
+			std::uint64_t internalBytes; // live bytes the driver allocated itself and reported
+		};
+
+		/**
+		 * @param blockSize Size of the blocks of the thread arenas
+		 */
+		explicit HostAllocator(std::size_t blockSize = 64 * 1024);
+
+		HostAllocator(HostAllocator&&) = delete;
+
+		HostAllocator(const HostAllocator&) = delete;
+
+		HostAllocator& operator=(HostAllocator&&) = delete;
+
+		HostAllocator& operator=(const HostAllocator&) = delete;
+
+		~HostAllocator();
+
+		/**
+		 * @return The callbacks of the installed HostAllocator, nullptr if there is none
+		 */
+		static VkAllocationCallbacks* getCallbacks();
+
+		[[nodiscard]] std::array<ScopeStatistics, ScopeCount> getStatistics() const;
+
+		/**
+		 * @brief Zeroes the call counters and sets the peaks to the live bytes, to measure a section of the program
+		 */
+		void resetCounters();
+
+		static const char* getScopeName(VkSystemAllocationScope scope);
+
+	private:
+		struct ScopeCounters
+		{
+			std::atomic<std::uint64_t> allocationCount;
+			std::atomic<std::uint64_t> reallocationCount;
+			std::atomic<std::uint64_t> freeCount;
+			std::atomic<std::uint64_t> arenaAllocationCount;
+			std::atomic<std::uint64_t> bytes;
+			std::atomic<std::uint64_t> peakBytes;
+			std::atomic<std::uint64_t> internalBytes;
+		};
+
+		static void* VKAPI_PTR allocation(void* userData, std::size_t size, std::size_t alignment,
+				VkSystemAllocationScope scope);
+
+		static void* VKAPI_PTR reallocation(void* userData, void* original, std::size_t size, std::size_t alignment,
+				VkSystemAllocationScope scope);
+
+		static void VKAPI_PTR free(void* userData, void* memory);
+
+		static void VKAPI_PTR internalAllocation(void* userData, std::size_t size, VkInternalAllocationType type,
+				VkSystemAllocationScope scope);
+
+		static void VKAPI_PTR internalFree(void* userData, std::size_t size, VkInternalAllocationType type,
+				VkSystemAllocationScope scope);
+
+		void* allocate(std::size_t size, std::size_t alignment, VkSystemAllocationScope scope);
+
+		void release(void* memory);
+
+		void addBytes(ScopeCounters& counters, std::size_t size);
+
+		static HostAllocator* _installed;
+
+		std::size_t _blockSize;
+		VkAllocationCallbacks _callbacks;
+		std::array<ScopeCounters, ScopeCount> _counters;
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_HOSTALLOCATOR_HPP
@@ -0,0 +1,54 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_MAPPEDFILE_HPP
+#define CONCERTOGRAPHICS_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief Read-only memory mapping of a whole file
+	 */
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+
+		MappedFile(MappedFile&& other) noexcept;
+
+		MappedFile(const MappedFile&) = delete;
+
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		~MappedFile();
+
+		/**
+		 * @return false if the file does not exist, is empty or cannot be mapped
+		 */
+		bool open(const std::string& path);
+
+		void close();
+
+		[[nodiscard]] bool isOpen() const;
+
+		[[nodiscard]] const std::byte* data() const;
+
+		[[nodiscard]] std::size_t size() const;
+
+	private:
+		const std::byte* _data = nullptr;
+		std::size_t _size = 0;
+#ifdef _WIN32
+		void* _file = nullptr;
+		void* _mapping = nullptr;
+#endif
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_MAPPEDFILE_HPP
\ No newline at end of file
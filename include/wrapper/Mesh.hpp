@@ -5,29 +5,254 @@
 #ifndef CONCERTOGRAPHICS_MESH_HPP
 #define CONCERTOGRAPHICS_MESH_HPP
 
+#include <cstddef>
+#include <optional>
+#include <span>
 #include <vector>
 #include <string>
 #include "AllocatedBuffer.hpp"
+#include "BoundingVolume.hpp"
+#include "BufferPool.hpp"
+#include "CommandBuffer.hpp"
+#include "GeometryArena.hpp"
+#include "MeshCache.hpp"
+#include "Meshlet.hpp"
+#include "MeshOptimizer.hpp"
+#include "MeshSimplifier.hpp"
+#include "UploadContext.hpp"
 #include "Vertex.hpp"
 #include "glm/glm.hpp"
 
 namespace Concerto::Graphics::Wrapper
 {
-	struct Mesh
+	struct MeshLoadOptions
 	{
-		Mesh(Vertices vertices, Allocator& allocator, std::size_t allocSize,
-				VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage);
+		/**
+		 * @brief Reorders triangles for the post-transform cache and overdraw, then vertices for fetch locality
+		 */
+		bool optimize = false;
+
+		/**
+		 * @brief Layout of the uploaded vertex buffer, see getVertexDescription(VertexFormat). VertexFormat::Packed
+		 * goes with the *_packed shaders.
+		 */
+		VertexFormat vertexFormat = VertexFormat::Standard;
+
+		/**
+		 * @brief Partitions the index buffer into meshlets for cullMeshlets()
+		 */
+		bool buildMeshlets = false;
+
+		/**
+		 * @brief Number of levels of detail, each one with about half the triangles of the previous one
+		 */
+		std::uint32_t lodCount = 1;
+	};
+
+	/**
+	 * @brief CPU side of a Mesh, everything that can be loaded without touching the device
+	 */
+	struct MeshData
+	{
+		explicit MeshData(Vertices vertices);
+
+		/**
+		 * @param file Wavefront OBJ or glTF 2.0 binary (.glb) file
+		 */
+		explicit MeshData(const std::string& file, const MeshLoadOptions& options = {});
+
+		MeshData(MeshData&&) = default;
+
+		MeshData(const MeshData&) = delete;
 
-		Mesh(const std::string& file, Allocator& allocator, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage);
+		MeshData& operator=(MeshData&&) = default;
 
+		MeshData& operator=(const MeshData&) = delete;
+
+		~MeshData() = default;
+
+		/**
+		 * @brief CPU copy of the geometry, left empty when the mesh comes from its binary cache or from a GLB
+		 * read straight into _vertexData
+		 */
 		Vertices _vertices;
+		/**
+		 * @brief _vertices encoded in _vertexFormat, left empty for VertexFormat::Standard
+		 */
+		std::vector<std::byte> _vertexData;
+		Indices _indices;
+		VertexFormat _vertexFormat;
+		std::size_t _vertexCount;
+		std::size_t _indexCount; // all levels of detail included
+		BoundingBox _boundingBox;
+		BoundingSphere _boundingSphere;
+		/**
+		 * @brief Vertex cache statistics before and after optimize(), zeroed if the mesh was not optimized
+		 */
+		MeshOptimizationStatistics _optimizationStatistics;
+		/**
+		 * @brief Index ranges of _indexBuffer with their culling bounds, empty unless built at load time
+		 */
+		Meshlets _meshlets;
+		/**
+		 * @brief Levels of detail stored one after the other in _indexBuffer, from the full detail one.
+		 * The meshlets only cover _lods[0].
+		 */
+		std::vector<MeshLod> _lods;
 
 		bool loadFromObj(const std::string& fileName, const std::string& materialPath);
 
+		/**
+		 * @brief Merges identical vertices, fills _indices and replaces _vertices by the unique ones
+		 */
+		void deduplicateVertices();
+
+		void optimize();
+
+		void buildMeshlets();
+
+		/**
+		 * @brief Appends lodCount - 1 simplified copies of _indices to _indices and fills _lods
+		 */
+		void buildLods(std::uint32_t lodCount, bool optimize);
+
+		/**
+		 * @brief Fills _vertexData from _vertices, quantized against _boundingBox for VertexFormat::Packed
+		 */
+		void encodeVertices();
+
+		/**
+		 * @brief Matrix bringing the vertex buffer positions back to model space, to apply before the model matrix.
+		 * Identity for VertexFormat::Standard.
+		 */
+		[[nodiscard]] glm::mat4 getPositionTransform() const;
+
+		[[nodiscard]] std::size_t getVertexStride() const;
+
+		/**
+		 * @brief Offset of the VertexAttributes stream in _vertexBuffer, the positions stream starts at 0.
+		 * Only meaningful for VertexFormat::Split.
+		 */
+		[[nodiscard]] VkDeviceSize getAttributeOffset() const;
+
+		/**
+		 * @brief Size in bytes of the vertex and index buffers
+		 */
+		[[nodiscard]] std::size_t getUploadSize() const;
+
+		MeshCache _cache;
 		bool _isLoaded;
-		AllocatedBuffer _vertexBuffer;
+	protected:
+		bool load(const std::string& file, const MeshLoadOptions& options);
+
+		bool loadFromObjWithTinyObj(const std::string& fileName, const std::string& materialPath);
+
+		/**
+		 * @param keepVertices Fills _vertices even if the upload layout does not need it, for the import time
+		 * processing. Otherwise VertexFormat::Split meshes are read directly into _vertexData.
+		 */
+		bool loadFromGlb(const std::string& fileName, bool keepVertices);
+
+		[[nodiscard]] std::span<const std::byte> getVertexData() const;
+	};
+
+	struct Mesh : MeshData
+	{
+		Mesh(Vertices vertices, Allocator& allocator, std::size_t allocSize,
+				VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage);
+
+		Mesh(const std::string& file, Allocator& allocator, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage,
+				const MeshLoadOptions& options = {});
+
+		/**
+		 * @brief Allocates the buffers of a mesh loaded beforehand, possibly on another thread, and uploads it
+		 */
+		Mesh(MeshData data, Allocator& allocator, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage);
+
+		/**
+		 * @brief Allocates GPU_ONLY buffers and records their upload in uploadContext, the mesh can be drawn
+		 * by the submissions following uploadContext.submit()
+		 *
+		 * The buffers are ranges of the BufferUsage::Geometry pool unless usage asks for more than that pool
+		 * provides.
+		 */
+		Mesh(MeshData data, UploadContext& uploadContext, VkBufferUsageFlags usage);
+
+		Mesh(const std::string& file, UploadContext& uploadContext, VkBufferUsageFlags usage,
+				const MeshLoadOptions& options = {});
+
+		/**
+		 * @brief Sub-allocates the mesh in arena instead of creating its own buffers, arena must use the
+		 * VertexFormat of data and outlive the mesh
+		 */
+		Mesh(MeshData data, GeometryArena& arena, UploadContext& uploadContext);
+
+		Mesh(Mesh&&) = delete;
+
+		Mesh(const Mesh&) = delete;
+
+		Mesh& operator=(Mesh&&) = delete;
+
+		Mesh& operator=(const Mesh&) = delete;
+
+		~Mesh();
+
+		/**
+		 * @brief Binds every vertex stream and the index buffer
+		 */
+		void bind(CommandBuffer& commandBuffer) const;
+
+		/**
+		 * @brief Binds the positions stream alone and the index buffer, only for VertexFormat::Split
+		 */
+		void bindPositions(CommandBuffer& commandBuffer) const;
+
+		/**
+		 * @brief Meshes returning the same pointer use the same buffers, drawing one after the other does not
+		 * need a new bind()
+		 */
+		[[nodiscard]] const void* getGeometryBinding() const;
+
+		/**
+		 * @brief vertexOffset of the draws of this mesh
+		 */
+		[[nodiscard]] std::int32_t getVertexOffset() const;
+
+		/**
+		 * @brief Position of the mesh indices in the bound index buffer, to add to the _lods and meshlets ranges
+		 */
+		[[nodiscard]] std::uint32_t getFirstIndex() const;
+
+		std::optional<AllocatedBuffer> _vertexBuffer; // empty for arena and pooled meshes
+		std::optional<AllocatedBuffer> _indexBuffer;
+		PooledBuffer _pooledVertexBuffer; // invalid unless the buffers come from the geometry pool
+		PooledBuffer _pooledIndexBuffer;
+		GeometryArena* _arena;
+		GeometryArena::Range _vertexRange;
+		GeometryArena::Range _indexRange;
 	private:
+		[[nodiscard]] std::span<const std::byte> getUploadVertexData() const;
+
+		[[nodiscard]] std::span<const std::byte> getUploadIndexData() const;
+
+		/**
+		 * @brief Writes the geometry through the persistent mapping of host visible buffers
+		 */
+		void upload();
+
+		void upload(UploadContext& uploadContext);
+
+		[[nodiscard]] VkBuffer getVertexBuffer() const;
+
+		/**
+		 * @brief Start of the mesh in getVertexBuffer(), 0 unless the buffer is a pool range
+		 */
+		[[nodiscard]] VkDeviceSize getVertexBufferOffset() const;
+
+		void bindVertexBuffer(CommandBuffer& commandBuffer) const;
+
+		void bindIndexBuffer(CommandBuffer& commandBuffer) const;
 	};
 } // Concerto::Graphics::Wrapper
 
-#endif //CONCERTOGRAPHICS_MESH_HPP
+#endif //CONCERTOGRAPHICS_MESH_HPP
\ No newline at end of file
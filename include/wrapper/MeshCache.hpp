@@ -0,0 +1,144 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_MESHCACHE_HPP
+#define CONCERTOGRAPHICS_MESHCACHE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include "MappedFile.hpp"
+#include "BoundingVolume.hpp"
+#include "Meshlet.hpp"
+#include "MeshOptimizer.hpp"
+#include "MeshSimplifier.hpp"
+#include "Vertex.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief Binary copy of a parsed mesh, stored next to its source file
+	 *
+	 * The cache is keyed on the absolute source path, the source modification time and size,
+	 * and a hash of the source content. The vertex and index blobs are laid out exactly as
+	 * they are uploaded so a cache hit costs a mapping and two memcpy.
+	 */
+	class MeshCache
+	{
+	public:
+		static constexpr std::uint32_t Magic = 0x4D474743; // "CGGM"
+		static constexpr std::uint32_t Version = 7;
+
+		static constexpr std::uint32_t FlagOptimized = 1 << 0;
+		static constexpr std::uint32_t FlagPackedVertices = 1 << 1;
+		static constexpr std::uint32_t FlagSplitVertices = 1 << 2;
+		static constexpr std::uint32_t FlagMeshlets = 1 << 3;
+		static constexpr std::uint32_t LodCountShift = 8; // bits 8 to 15 hold the requested number of LODs
+
+		enum Blob : std::uint32_t
+		{
+			BlobVertices,
+			BlobIndices,
+			BlobMeshlets,
+			BlobLods,
+			BlobCount
+		};
+		using Blobs = std::array<std::span<const std::byte>, BlobCount>;
+
+		/**
+		 * @brief Everything that was computed at import time and is not part of a blob
+		 */
+		struct Metadata
+		{
+			std::uint32_t flags;
+			BoundingBox boundingBox;
+			BoundingSphere boundingSphere;
+			MeshOptimizationStatistics optimizationStatistics;
+		};
+
+		struct BlobRange
+		{
+			std::uint64_t offset;
+			std::uint64_t size;
+		};
+
+		struct Header
+		{
+			std::uint32_t magic;
+			std::uint32_t version;
+			std::uint64_t pathHash;
+			std::int64_t sourceTime;
+			std::uint64_t sourceSize;
+			std::uint64_t contentHash;
+			std::uint32_t vertexStride;
+			std::uint64_t vertexCount;
+			BlobRange blobs[BlobCount];
+			Metadata metadata;
+		};
+
+		MeshCache() = default;
+
+		MeshCache(MeshCache&&) = default;
+
+		MeshCache(const MeshCache&) = delete;
+
+		MeshCache& operator=(MeshCache&&) = default;
+
+		MeshCache& operator=(const MeshCache&) = delete;
+
+		~MeshCache() = default;
+
+		static std::string getCachePath(const std::string& sourcePath);
+
+		/**
+		 * @brief Maps the cache of sourcePath
+		 * @return false if there is no cache, if it does not match the source file anymore, if it was
+		 * built with other flags or if a blob, LOD or meshlet range is out of bounds
+		 */
+		bool open(const std::string& sourcePath, std::uint32_t flags);
+
+		void close();
+
+		[[nodiscard]] bool isOpen() const;
+
+		/**
+		 * @brief Raw vertex blob, laid out as the VertexFormat given by the flags
+		 */
+		[[nodiscard]] std::span<const std::byte> getVertexData() const;
+
+		[[nodiscard]] std::size_t getVertexCount() const;
+
+		[[nodiscard]] std::span<const std::uint32_t> getIndices() const;
+
+		[[nodiscard]] std::span<const Meshlet> getMeshlets() const;
+
+		[[nodiscard]] std::span<const MeshLod> getLods() const;
+
+		[[nodiscard]] std::span<const std::byte> getBlob(Blob blob) const;
+
+		[[nodiscard]] const Metadata& getMetadata() const;
+
+		/**
+		 * @brief Writes the cache of sourcePath, blobs[BlobVertices] holds vertexCount vertices in the layout
+		 * given by metadata.flags
+		 */
+		static bool write(const std::string& sourcePath, const Blobs& blobs, std::size_t vertexCount,
+				const Metadata& metadata);
+
+		static std::uint32_t getVertexStride(std::uint32_t flags);
+
+	private:
+		/**
+		 * @brief Maps cachePath and checks its header and ranges, the cache is closed when they do not match
+		 */
+		bool map(const std::string& cachePath, std::uint32_t flags, std::uint64_t pathHash, std::uint64_t sourceSize);
+
+		MappedFile _file;
+		Header _header{};
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_MESHCACHE_HPP
\ No newline at end of file
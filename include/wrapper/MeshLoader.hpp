@@ -0,0 +1,114 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_MESHLOADER_HPP
+#define CONCERTOGRAPHICS_MESHLOADER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Allocator.hpp"
+#include "GeometryArena.hpp"
+#include "Mesh.hpp"
+#include "UploadContext.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief Loads meshes in the background
+	 *
+	 * Files are parsed (or read from their cache) on a pool of worker threads into MeshData. The buffer
+	 * allocations and copies stay on the render thread: update() uploads the parsed meshes within a byte
+	 * budget, so a frame only pays for the meshes it uploads. GPU_ONLY meshes go through the UploadContext
+	 * given at construction, the copies of one update() share a single submission.
+	 */
+	class MeshLoader
+	{
+	public:
+		/**
+		 * @param threadCount Number of worker threads, 0 uses a quarter of the hardware concurrency since
+		 * the OBJ parser already spreads every file over all the cores
+		 */
+		explicit MeshLoader(Allocator& allocator, std::size_t threadCount = 0);
+
+		explicit MeshLoader(UploadContext& uploadContext, std::size_t threadCount = 0);
+
+		MeshLoader(MeshLoader&&) = delete;
+
+		MeshLoader(const MeshLoader&) = delete;
+
+		MeshLoader& operator=(MeshLoader&&) = delete;
+
+		MeshLoader& operator=(const MeshLoader&) = delete;
+
+		/**
+		 * @brief Waits for the files being parsed, the futures of the meshes not uploaded yet are abandoned
+		 */
+		~MeshLoader();
+
+		/**
+		 * @brief Queues file for loading on a worker thread
+		 * @return A future that becomes ready in the update() call uploading the mesh, or holds the
+		 * exception thrown while loading it
+		 */
+		std::future<std::unique_ptr<Mesh>> loadAsync(const std::string& file, VkBufferUsageFlags usage,
+				VmaMemoryUsage memoryUsage, const MeshLoadOptions& options = {});
+
+		/**
+		 * @brief Same as above but the mesh is sub-allocated in arena, which needs the VertexFormat of options.
+		 * Only for loaders built on an UploadContext.
+		 */
+		std::future<std::unique_ptr<Mesh>> loadAsync(const std::string& file, GeometryArena& arena,
+				const MeshLoadOptions& options = {});
+
+		/**
+		 * @brief Uploads the parsed meshes, to call once per frame from the render thread
+		 * @param byteBudget Upload size after which the remaining meshes wait for the next call. One mesh
+		 * is always uploaded so a mesh larger than the budget does not wait forever.
+		 * @return The number of uploaded meshes
+		 */
+		std::size_t update(std::size_t byteBudget);
+
+		/**
+		 * @return The number of meshes queued, being parsed or waiting for their upload
+		 */
+		[[nodiscard]] std::size_t getPendingCount() const;
+
+	private:
+		struct Job
+		{
+			std::string file;
+			VkBufferUsageFlags usage;
+			VmaMemoryUsage memoryUsage;
+			MeshLoadOptions options;
+			GeometryArena* arena;
+			std::promise<std::unique_ptr<Mesh>> promise;
+			std::optional<MeshData> data;
+		};
+
+		std::future<std::unique_ptr<Mesh>> queue(Job job);
+
+		void run();
+
+		Allocator& _allocator;
+		UploadContext* _uploadContext;
+		std::vector<std::thread> _workers;
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		std::deque<Job> _jobs;
+		std::deque<Job> _parsed;
+		std::atomic<std::size_t> _pendingCount;
+		bool _stop;
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_MESHLOADER_HPP
@@ -0,0 +1,56 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_MESHOPTIMIZER_HPP
+#define CONCERTOGRAPHICS_MESHOPTIMIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "Vertex.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	constexpr std::size_t DefaultVertexCacheSize = 16;
+
+	struct VertexCacheStatistics
+	{
+		float acmr; // vertex shader invocations per triangle, 0.5 is the best a regular grid can do, 3 the worst
+		float atvr; // vertex shader invocations per referenced vertex, 1 is optimal
+	};
+
+	struct MeshOptimizationStatistics
+	{
+		VertexCacheStatistics before;
+		VertexCacheStatistics after;
+	};
+
+	/**
+	 * @brief Simulates a FIFO post-transform cache over a triangle list
+	 */
+	VertexCacheStatistics analyzeVertexCache(std::span<const std::uint32_t> indices, std::size_t vertexCount,
+			std::size_t cacheSize = DefaultVertexCacheSize);
+
+	/**
+	 * @brief Reorders triangles for post-transform cache locality (Tipsify, Sander et al. 2007)
+	 */
+	Indices optimizeVertexCache(std::span<const std::uint32_t> indices, std::size_t vertexCount,
+			std::size_t cacheSize = DefaultVertexCacheSize);
+
+	/**
+	 * @brief Reorders clusters of a cache optimized triangle list so that outward facing ones are drawn first
+	 * @param threshold Allowed ACMR degradation, 1.05 lets the cache efficiency drop by 5% to get smaller clusters
+	 */
+	Indices optimizeOverdraw(std::span<const std::uint32_t> indices, std::span<const Vertex> vertices,
+			float threshold = 1.05f, std::size_t cacheSize = DefaultVertexCacheSize);
+
+	/**
+	 * @brief Reorders the vertices in the order the index buffer first references them and remaps the indices
+	 *
+	 * Vertices that are not referenced are dropped.
+	 */
+	void optimizeVertexFetch(Vertices& vertices, Indices& indices);
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_MESHOPTIMIZER_HPP
\ No newline at end of file
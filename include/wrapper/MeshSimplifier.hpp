@@ -0,0 +1,46 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_MESHSIMPLIFIER_HPP
+#define CONCERTOGRAPHICS_MESHSIMPLIFIER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include "Vertex.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief Index range of one level of detail in a mesh index buffer
+	 */
+	struct MeshLod
+	{
+		std::uint32_t firstIndex;
+		std::uint32_t indexCount;
+		/**
+		 * @brief Quadric error of the level, accumulated over the levels before it: the root of the area weighted
+		 * mean squared distance to the original triangle planes, in model space units. An estimate of the
+		 * deviation, not a bound.
+		 */
+		float error;
+	};
+
+	/**
+	 * @brief Quadric error metric edge collapse (Garland & Heckbert 1997) that only moves vertices onto
+	 * existing ones, so the result still indexes the same vertex buffer
+	 *
+	 * Vertices sharing a position collapse together, vertices on open borders and on attribute seams are locked.
+	 * @param targetIndexCount Stops once the index count drops to this value
+	 * @param targetError Largest allowed quadric error of a collapse, in model space units
+	 * @param resultError If not null, receives the largest quadric error of the applied collapses, the root of
+	 * a mean squared distance to the original planes, in model space units
+	 */
+	Indices simplifyMesh(std::span<const std::uint32_t> indices, std::span<const Vertex> vertices,
+			std::size_t targetIndexCount, float targetError = std::numeric_limits<float>::max(),
+			float* resultError = nullptr);
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_MESHSIMPLIFIER_HPP
\ No newline at end of file
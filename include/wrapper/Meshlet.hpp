@@ -0,0 +1,69 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_MESHLET_HPP
+#define CONCERTOGRAPHICS_MESHLET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "glm/glm.hpp"
+#include "BoundingVolume.hpp"
+#include "Vertex.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	constexpr std::size_t MaxMeshletVertices = 64;
+	constexpr std::size_t MaxMeshletTriangles = 124;
+
+	/**
+	 * @brief Cluster of consecutive triangles of a mesh index buffer
+	 */
+	struct Meshlet
+	{
+		std::uint32_t firstIndex;
+		std::uint32_t triangleCount;
+		std::uint32_t vertexCount;
+		BoundingSphere boundingSphere;
+		glm::vec3 coneApex;
+		glm::vec3 coneAxis;
+		float coneCutoff; // 1 when the triangles face too many directions for the cluster to be backface culled
+	};
+	using Meshlets = std::vector<Meshlet>;
+
+	struct IndexRange
+	{
+		std::uint32_t firstIndex;
+		std::uint32_t indexCount;
+	};
+
+	struct MeshletCullingStatistics
+	{
+		std::size_t visibleMeshlets;
+		std::size_t visibleTriangles;
+		std::size_t frustumCulledTriangles;
+		std::size_t backfaceCulledTriangles;
+	};
+
+	/**
+	 * @brief Splits a triangle list into meshlets, in index buffer order so each meshlet is a contiguous index range
+	 *
+	 * Run it after optimizeVertexCache(), the meshlets are only as tight as the triangle order is local.
+	 */
+	Meshlets buildMeshlets(std::span<const std::uint32_t> indices, std::span<const Vertex> vertices,
+			std::size_t maxVertices = MaxMeshletVertices, std::size_t maxTriangles = MaxMeshletTriangles);
+
+	/**
+	 * @brief Frustum and normal cone culling, appends the index ranges of the visible meshlets to ranges
+	 *
+	 * Consecutive visible meshlets are merged into a single range. The backface test assumes a closed mesh.
+	 * @param frustum The frustum in the mesh model space
+	 * @param cameraPosition The camera position in the mesh model space
+	 */
+	MeshletCullingStatistics cullMeshlets(std::span<const Meshlet> meshlets, const Frustum& frustum,
+			const glm::vec3& cameraPosition, std::vector<IndexRange>& ranges);
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_MESHLET_HPP
\ No newline at end of file
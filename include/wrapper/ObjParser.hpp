@@ -0,0 +1,71 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_OBJPARSER_HPP
+#define CONCERTOGRAPHICS_OBJPARSER_HPP
+
+#include <cstddef>
+#include <string>
+#include "Vertex.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief Multi-threaded Wavefront OBJ geometry parser
+	 *
+	 * The file is mapped, split at line boundaries and every chunk is parsed on its own thread.
+	 * The chunks are then stitched into a pre-sized triangle list that is bit identical to what
+	 * parseWithTinyObj produces (triangles and quads, the quad being split along its shortest diagonal,
+	 * numbers parsed with tinyobj's own algorithm). Faces with more than four corners are reported as
+	 * Unsupported so the caller can fall back to tinyobj's ear clipping.
+	 */
+	class ObjParser
+	{
+	public:
+		enum class Result
+		{
+			Success,
+			Unsupported,
+			Error
+		};
+
+		/**
+		 * @param threadCount Number of parsing threads, 0 uses the hardware concurrency
+		 */
+		explicit ObjParser(std::size_t threadCount = 0);
+
+		Result parse(const std::string& fileName, Vertices& vertices);
+
+		/**
+		 * @brief Single-threaded reference path, triangulates any polygon
+		 * @return False if tinyobj failed to read the file
+		 */
+		static bool parseWithTinyObj(const std::string& fileName, const std::string& materialPath,
+				Vertices& vertices);
+
+		[[nodiscard]] std::size_t getThreadCount() const;
+
+		/**
+		 * @return The size in bytes of the last parsed file
+		 */
+		[[nodiscard]] std::size_t getParsedBytes() const;
+
+		/**
+		 * @return The duration of the last parse in seconds
+		 */
+		[[nodiscard]] double getParseTime() const;
+
+		/**
+		 * @return The throughput of the last parse in MB/s
+		 */
+		[[nodiscard]] double getThroughput() const;
+
+	private:
+		std::size_t _threadCount;
+		std::size_t _parsedBytes;
+		double _parseTime;
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_OBJPARSER_HPP
\ No newline at end of file
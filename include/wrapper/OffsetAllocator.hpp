@@ -0,0 +1,57 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_OFFSETALLOCATOR_HPP
+#define CONCERTOGRAPHICS_OFFSETALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief Sub-allocates ranges of [0, size), it only does the bookkeeping and never touches memory
+	 *
+	 * Allocations are best fit. Freed ranges are merged with their free neighbours, so freeing
+	 * everything always gives back a single range.
+	 */
+	class OffsetAllocator
+	{
+	public:
+		explicit OffsetAllocator(std::uint64_t size);
+
+		/**
+		 * @param alignment Multiple the returned offset is rounded up to, does not have to be a power of two
+		 * @return The offset of the range, std::nullopt if no free range is large enough
+		 */
+		std::optional<std::uint64_t> allocate(std::uint64_t size, std::uint64_t alignment = 1);
+
+		/**
+		 * @brief Gives back a range returned by allocate(), with the size that was requested
+		 */
+		void free(std::uint64_t offset, std::uint64_t size);
+
+		[[nodiscard]] std::uint64_t getSize() const;
+
+		[[nodiscard]] std::uint64_t getFreeSize() const;
+
+		[[nodiscard]] std::uint64_t getLargestFreeRange() const;
+
+		[[nodiscard]] std::size_t getFreeRangeCount() const;
+
+	private:
+		void insertFreeRange(std::uint64_t offset, std::uint64_t size);
+
+		void eraseFreeRange(std::map<std::uint64_t, std::uint64_t>::iterator it);
+
+		std::map<std::uint64_t, std::uint64_t> _freeByOffset; // offset -> size
+		std::multimap<std::uint64_t, std::uint64_t> _freeBySize; // size -> offset
+		std::uint64_t _size;
+		std::uint64_t _freeSize;
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_OFFSETALLOCATOR_HPP
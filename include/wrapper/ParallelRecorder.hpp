@@ -0,0 +1,109 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_PARALLELRECORDER_HPP
+#define CONCERTOGRAPHICS_PARALLELRECORDER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "vulkan/vulkan.h"
+#include "CommandAllocator.hpp"
+#include "CommandBuffer.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief Records a range of items into secondary command buffers on several threads
+	 *
+	 * record() splits [0, count) into contiguous chunks, one per thread, each recorded into a secondary command
+	 * buffer of its thread and executed in order into the primary command buffer, so the result draws the same
+	 * as recording the whole range inline. The calling thread records the first chunk. Every thread has one
+	 * CommandAllocator per frame in flight, only used by its thread and only reset once the frame using it is
+	 * done.
+	 */
+	class ParallelRecorder
+	{
+	public:
+		/**
+		 * @brief Records the items [first, last) into commandBuffer, the bound state starts empty
+		 */
+		using RecordFunction = std::function<void(CommandBuffer& commandBuffer, std::size_t first, std::size_t last)>;
+
+		/**
+		 * @param frameCount Number of frames in flight
+		 * @param threadCount Number of recording threads including the calling one, 0 uses the hardware
+		 * concurrency
+		 * @param minChunkSize Fewest items worth a thread, smaller ranges use fewer threads
+		 */
+		ParallelRecorder(VkDevice device, std::uint32_t queueFamily, std::size_t frameCount,
+				std::size_t threadCount = 0, std::size_t minChunkSize = 256);
+
+		ParallelRecorder(ParallelRecorder&&) = delete;
+
+		ParallelRecorder(const ParallelRecorder&) = delete;
+
+		ParallelRecorder& operator=(ParallelRecorder&&) = delete;
+
+		ParallelRecorder& operator=(const ParallelRecorder&) = delete;
+
+		~ParallelRecorder();
+
+		/**
+		 * @brief To call once per frame after waiting for the fence of the frame, resets its command allocators
+		 */
+		void beginFrame(std::size_t frameIndex);
+
+		/**
+		 * @brief Records count items with recordFunction and executes them into commandBuffer
+		 *
+		 * commandBuffer must be in the render pass and subpass of inheritanceInfo, begun with
+		 * VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS. recordFunction is called concurrently on disjoint ranges.
+		 */
+		void record(CommandBuffer& commandBuffer, const VkCommandBufferInheritanceInfo& inheritanceInfo,
+				std::size_t count, const RecordFunction& recordFunction);
+
+		[[nodiscard]] std::size_t getThreadCount() const;
+
+		/**
+		 * @brief State command counters of every secondary command buffer recorded since beginFrame()
+		 */
+		[[nodiscard]] const StateStatistics& getStateStatistics() const;
+
+	private:
+		void run(std::size_t thread);
+
+		void recordChunk(std::size_t thread);
+
+		VkDevice _device;
+		std::size_t _threadCount;
+		std::size_t _minChunkSize;
+		std::vector<std::vector<std::unique_ptr<CommandAllocator>>> _frames; // [frame][thread]
+		std::size_t _frameIndex;
+		std::vector<std::thread> _workers;
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		std::condition_variable _doneCondition;
+		std::uint64_t _generation;
+		std::size_t _remaining;
+		bool _stop;
+		// The job of the current generation
+		const RecordFunction* _recordFunction;
+		const VkCommandBufferInheritanceInfo* _inheritanceInfo;
+		std::size_t _count;
+		std::size_t _chunkCount;
+		std::vector<VkCommandBuffer> _recorded;
+		std::vector<StateStatistics> _recordedStatistics;
+		StateStatistics _frameStatistics;
+		std::exception_ptr _error;
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_PARALLELRECORDER_HPP
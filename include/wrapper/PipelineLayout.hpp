@@ -16,8 +16,13 @@ namespace Concerto::Graphics::Wrapper
 	class PipelineLayout
 	{
 	public:
+		/**
+		 * @param size Size of the push constant range, starting at offset 0
+		 * @param pushConstantStages Stages reading the push constants
+		 */
 		PipelineLayout(VkDevice device, std::size_t size,
-				const std::vector<std::reference_wrapper<DescriptorSetLayout>>& descriptorSetLayouts);
+				const std::vector<std::reference_wrapper<DescriptorSetLayout>>& descriptorSetLayouts,
+				VkShaderStageFlags pushConstantStages = VK_SHADER_STAGE_VERTEX_BIT);
 
 		PipelineLayout(PipelineLayout&&) = default;
 
@@ -38,9 +43,10 @@ namespace Concerto::Graphics::Wrapper
 
 	template<typename T>
 	PipelineLayout makePipelineLayout(VkDevice device,
-			const std::vector<std::reference_wrapper<DescriptorSetLayout>>& descriptorSetLayouts)
+			const std::vector<std::reference_wrapper<DescriptorSetLayout>>& descriptorSetLayouts,
+			VkShaderStageFlags pushConstantStages = VK_SHADER_STAGE_VERTEX_BIT)
 	{
-		return { device, sizeof(T), descriptorSetLayouts };
+		return { device, sizeof(T), descriptorSetLayouts, pushConstantStages };
 	}
 } // Concerto::Graphics::Wrapper
 
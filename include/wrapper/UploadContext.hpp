@@ -0,0 +1,115 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#ifndef CONCERTOGRAPHICS_UPLOADCONTEXT_HPP
+#define CONCERTOGRAPHICS_UPLOADCONTEXT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <vector>
+#include "vulkan/vulkan.h"
+#include "Allocator.hpp"
+#include "AllocatedBuffer.hpp"
+#include "CommandBuffer.hpp"
+#include "CommandPool.hpp"
+#include "Fence.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	/**
+	 * @brief Copies data into device local buffers through a staging ring
+	 *
+	 * upload() writes into a persistently mapped CPU_TO_GPU ring and records the copy in the current batch.
+	 * submit() sends the whole batch in a single vkQueueSubmit. The ring space of a batch is reclaimed once
+	 * its fence is signaled, upload() only blocks when the ring or every batch is still in use.
+	 *
+	 * The batch ends with a barrier making the copies visible to the vertex input stage, so the queue must
+	 * be the one rendering the uploaded buffers: later submissions to it can use them right away.
+	 */
+	class UploadContext
+	{
+	public:
+		static constexpr std::size_t BatchCount = 3;
+
+		UploadContext(Allocator& allocator, VkDevice device, VkQueue queue, std::uint32_t queueFamily,
+				std::size_t stagingSize = 32 * 1024 * 1024);
+
+		UploadContext(UploadContext&&) = delete;
+
+		UploadContext(const UploadContext&) = delete;
+
+		UploadContext& operator=(UploadContext&&) = delete;
+
+		UploadContext& operator=(const UploadContext&) = delete;
+
+		/**
+		 * @brief Submits the pending copies and waits for all of them
+		 */
+		~UploadContext();
+
+		/**
+		 * @brief Copies data into buffer at offset, the buffer needs VK_BUFFER_USAGE_TRANSFER_DST_BIT.
+		 * data can be released as soon as the call returns.
+		 */
+		void upload(const AllocatedBuffer& buffer, VkDeviceSize offset, std::span<const std::byte> data);
+
+		/**
+		 * @brief Same as above for a range of a BufferPool, offset being relative to the start of the range
+		 */
+		void upload(const PooledBuffer& buffer, VkDeviceSize offset, std::span<const std::byte> data);
+
+		/**
+		 * @brief Submits the copies recorded since the last call, does nothing if there are none
+		 */
+		void submit();
+
+		/**
+		 * @brief Submits the pending copies and waits until they are all done
+		 */
+		void flush();
+
+		[[nodiscard]] Allocator& getAllocator() const;
+
+	private:
+		struct Batch
+		{
+			Batch(VkDevice device, VkCommandPool commandPool);
+
+			Fence fence;
+			CommandBuffer commandBuffer;
+			std::size_t stagingUsed;
+		};
+
+		void upload(VkBuffer buffer, VkDeviceSize offset, std::span<const std::byte> data);
+
+		/**
+		 * @return The offset of size free bytes in the staging ring, waiting for the older batches if needed
+		 */
+		VkDeviceSize allocateStaging(std::size_t size);
+
+		Batch& getRecordingBatch();
+
+		void retireOldestBatch();
+
+		Allocator& _allocator;
+		VkDevice _device;
+		VkQueue _queue;
+		CommandPool _commandPool;
+		std::vector<std::unique_ptr<Batch>> _batches;
+		std::deque<std::size_t> _inFlight; // oldest first
+		std::size_t _current;
+		bool _recording;
+		AllocatedBuffer _stagingBuffer;
+		std::byte* _stagingData;
+		std::size_t _stagingSize;
+		std::size_t _stagingHead;
+		std::size_t _stagingUsed; // in flight and recorded bytes, wasted space at the end of the ring included
+		std::size_t _recordingUsed;
+	};
+} // Concerto::Graphics::Wrapper
+
+#endif //CONCERTOGRAPHICS_UPLOADCONTEXT_HPP
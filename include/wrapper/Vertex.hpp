@@ -5,6 +5,9 @@
 #ifndef CONCERTOGRAPHICS_VERTEX_HPP
 #define CONCERTOGRAPHICS_VERTEX_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <glm/vec3.hpp>
 #include <glm/glm.hpp>
 #include <vulkan/vulkan.hpp>
@@ -29,9 +32,71 @@ namespace Concerto::Graphics::Wrapper
 		glm::vec2 uv;
 
 		static VertexInputDescription getVertexDescription();
+
+		/**
+		 * @brief Binding 0 holds the positions, binding 1 the VertexAttributes
+		 */
+		static VertexInputDescription getSplitVertexDescription();
+
+		/**
+		 * @brief Binding 0 of getSplitVertexDescription() alone, for depth-only pipelines
+		 */
+		static VertexInputDescription getPositionVertexDescription();
+
+		bool operator==(const Vertex& other) const;
+	};
+
+	/**
+	 * @brief Vertex without its position, second stream of VertexFormat::Split
+	 */
+	struct VertexAttributes
+	{
+		glm::vec3 normal;
+		glm::vec3 color;
+		glm::vec2 uv;
 	};
 	using Vertices = std::vector<Vertex>;
+	using Indices = std::vector<std::uint32_t>;
+
+	enum class VertexFormat : std::uint32_t
+	{
+		Standard, // Vertex, 44 bytes
+		Packed, // PackedVertex, 12 bytes
+		Split // glm::vec3 positions followed by VertexAttributes, bound as two streams
+	};
+
+	/**
+	 * @brief Quantized vertex: unorm16 position relative to the mesh bounding box, octahedral snorm8 normal
+	 * and half float uv. The color is not stored, the shaders derive it from the normal.
+	 */
+	struct PackedVertex
+	{
+		std::uint16_t position[3];
+		std::uint8_t normal[2];
+		std::uint16_t uv[2];
+
+		static VertexInputDescription getVertexDescription();
+
+		/**
+		 * @brief Quantizes vertex, the position is remapped from [boundsMin, boundsMin + boundsExtent] to [0, 1]
+		 */
+		static PackedVertex pack(const Vertex& vertex, const glm::vec3& boundsMin, const glm::vec3& boundsExtent);
+	};
+	static_assert(sizeof(PackedVertex) == 12);
+
+	VertexInputDescription getVertexDescription(VertexFormat format);
+
+	/**
+	 * @brief Bytes per vertex, both streams included for VertexFormat::Split
+	 */
+	std::size_t getVertexStride(VertexFormat format);
 
 } // Concerto
 
+template<>
+struct std::hash<Concerto::Graphics::Wrapper::Vertex>
+{
+	std::size_t operator()(const Concerto::Graphics::Wrapper::Vertex& vertex) const noexcept;
+};
+
 #endif //CONCERTOGRAPHICS_VERTEX_HPP
@@ -27,6 +27,7 @@ namespace VulkanInitializer
 	VkFenceCreateInfo FenceCreateInfo(VkFenceCreateFlagBits bits = static_cast<VkFenceCreateFlagBits>(0));
 	VkSemaphoreCreateInfo SemaphoreCreateInfo(VkSemaphoreCreateFlags flags = 0);
 	VkCommandBufferAllocateInfo CommandBufferAllocateInfo(VkCommandPool pool, int count, VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+	VkCommandBufferInheritanceInfo CommandBufferInheritanceInfo(VkRenderPass renderPass, std::uint32_t subpass, VkFramebuffer framebuffer);
 	VkFramebufferCreateInfo FramebufferCreateInfo(VkRenderPass pT, VkExtent2D extent2D);
 	VkDescriptorSetLayoutBinding DescriptorSetLayoutBinding(VkDescriptorType type, VkShaderStageFlags stageFlags, uint32_t binding);
 	VkWriteDescriptorSet WriteDescriptorBuffer(VkDescriptorType type, VkDescriptorSet dstSet, VkDescriptorBufferInfo* bufferInfo , uint32_t binding);
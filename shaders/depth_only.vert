@@ -0,0 +1,23 @@
+#version 450
+layout (location = 0) in vec3 vPosition;
+
+layout(set = 0, binding = 0) uniform  CameraBuffer{
+    mat4 view;
+    mat4 proj;
+    mat4 viewproj;
+} cameraData;
+
+//push constants block
+layout( push_constant ) uniform constants
+{
+    vec4 data;
+    mat4 render_matrix;
+} PushConstants;
+
+invariant gl_Position;
+
+void main()
+{
+    mat4 transformMatrix = (cameraData.viewproj * PushConstants.render_matrix);
+    gl_Position = transformMatrix * vec4(vPosition, 1.0f);
+}
@@ -0,0 +1,25 @@
+#version 460
+layout (location = 0) in vec3 vPosition;
+
+layout(set = 0, binding = 0) uniform  CameraBuffer{
+    mat4 view;
+    mat4 proj;
+    mat4 viewproj;
+} cameraData;
+
+struct ObjectData{
+    mat4 model;
+};
+
+//all object matrices, indexed by the firstInstance of the indirect draw
+layout(std140, set = 1, binding = 0) readonly buffer ObjectBuffer{
+    ObjectData objects[];
+} objectBuffer;
+
+invariant gl_Position;
+
+void main()
+{
+    mat4 transformMatrix = (cameraData.viewproj * objectBuffer.objects[gl_BaseInstance].model);
+    gl_Position = transformMatrix * vec4(vPosition, 1.0f);
+}
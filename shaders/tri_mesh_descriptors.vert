@@ -5,6 +5,9 @@ layout (location = 2) in vec3 vColor;
 
 layout (location = 0) out vec3 outColor;
 
+//must match depth_only.vert bit for bit so the depth prepass and this pass produce the same depth
+invariant gl_Position;
+
 layout(set = 0, binding = 0) uniform  CameraBuffer{
     mat4 view;
     mat4 proj;
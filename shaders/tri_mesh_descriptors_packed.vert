@@ -0,0 +1,35 @@
+#version 450
+layout (location = 0) in vec4 vPosition;
+layout (location = 1) in vec2 vNormal;
+
+layout (location = 0) out vec3 outColor;
+
+layout(set = 0, binding = 0) uniform  CameraBuffer{
+    mat4 view;
+    mat4 proj;
+    mat4 viewproj;
+} cameraData;
+
+//push constants block
+layout( push_constant ) uniform constants
+{
+    vec4 data;
+    mat4 render_matrix;
+} PushConstants;
+
+vec3 decodeOctahedral(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+void main()
+{
+    //render_matrix already contains the dequantization from the mesh bounds
+    mat4 transformMatrix = (cameraData.viewproj * PushConstants.render_matrix);
+    gl_Position = transformMatrix * vec4(vPosition.xyz, 1.0f);
+    outColor = decodeOctahedral(vNormal);
+}
\ No newline at end of file
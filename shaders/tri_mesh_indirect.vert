@@ -0,0 +1,31 @@
+#version 460
+layout (location = 0) in vec3 vPosition;
+layout (location = 1) in vec3 vNormal;
+layout (location = 2) in vec3 vColor;
+
+layout (location = 0) out vec3 outColor;
+
+//must match depth_only_indirect.vert bit for bit so the depth prepass and this pass produce the same depth
+invariant gl_Position;
+
+layout(set = 0, binding = 0) uniform  CameraBuffer{
+    mat4 view;
+    mat4 proj;
+    mat4 viewproj;
+} cameraData;
+
+struct ObjectData{
+    mat4 model;
+};
+
+//all object matrices, indexed by the firstInstance of the indirect draw
+layout(std140, set = 1, binding = 0) readonly buffer ObjectBuffer{
+    ObjectData objects[];
+} objectBuffer;
+
+void main()
+{
+    mat4 transformMatrix = (cameraData.viewproj * objectBuffer.objects[gl_BaseInstance].model);
+    gl_Position = transformMatrix * vec4(vPosition, 1.0f);
+    outColor = vColor;
+}
@@ -0,0 +1,37 @@
+#version 460
+layout (location = 0) in vec4 vPosition;
+layout (location = 1) in vec2 vNormal;
+
+layout (location = 0) out vec3 outColor;
+
+layout(set = 0, binding = 0) uniform  CameraBuffer{
+    mat4 view;
+    mat4 proj;
+    mat4 viewproj;
+} cameraData;
+
+struct ObjectData{
+    mat4 model;
+};
+
+//all object matrices, indexed by the firstInstance of the indirect draw
+layout(std140, set = 1, binding = 0) readonly buffer ObjectBuffer{
+    ObjectData objects[];
+} objectBuffer;
+
+vec3 decodeOctahedral(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+void main()
+{
+    //the model matrix already contains the dequantization from the mesh bounds
+    mat4 transformMatrix = (cameraData.viewproj * objectBuffer.objects[gl_BaseInstance].model);
+    gl_Position = transformMatrix * vec4(vPosition.xyz, 1.0f);
+    outColor = decodeOctahedral(vNormal);
+}
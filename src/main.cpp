@@ -2,7 +2,7 @@
 // Created by arthur on 12/07/2022.
 //
 #define VMA_IMPLEMENTATION
-#define VMA_VULKAN_VERSION 1000000
+#define VMA_VULKAN_VERSION 1001000 // matches the vulkanApiVersion given to vmaCreateAllocator
 #define VKB_DEBUG
 
 #include "MeshPushConstants.hpp"
@@ -13,8 +13,10 @@
 #include "wrapper/RenderPass.hpp"
 #include "wrapper/FrameBuffer.hpp"
 #include "wrapper/CommandBuffer.hpp"
-#include "wrapper/CommandPool.hpp"
+#include "wrapper/CommandAllocator.hpp"
 #include "wrapper/Fence.hpp"
+#include "wrapper/Defragmenter.hpp"
+#include "wrapper/DeletionQueue.hpp"
 #include "wrapper/DescriptorSet.hpp"
 #include "wrapper/DescriptorSetLayout.hpp"
 #include "wrapper/DescriptorPool.hpp"
@@ -31,9 +33,25 @@
 #include "window/GlfW3.hpp"
 #include "wrapper/Swapchain.hpp"
 #include "wrapper/Mesh.hpp"
+#include "wrapper/GeometryArena.hpp"
+#include "wrapper/MeshLoader.hpp"
+#include "wrapper/ParallelRecorder.hpp"
+#include "wrapper/UploadContext.hpp"
+#include "wrapper/FrameAllocator.hpp"
+#include "wrapper/HostAllocator.hpp"
+#include "wrapper/ComputePipeline.hpp"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <unordered_map>
+#include <tuple>
+#include <map>
 #include <array>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <optional>
+#include <utility>
 
 VkInstance _instance{ VK_NULL_HANDLE };
 VkDebugUtilsMessengerEXT _debug_messenger;
@@ -41,12 +59,26 @@ VkPhysicalDevice _chosenGPU{ VK_NULL_HANDLE };
 VkDevice _device{ VK_NULL_HANDLE };
 VkSurfaceKHR _surface{ VK_NULL_HANDLE };
 int _frameNumber = 0;
+bool _indirectDraws = false; // multiDrawIndirect and drawIndirectFirstInstance are enabled
+bool _gpuCulling = false; // _indirectDraws and VK_KHR_draw_indirect_count, the culling shader writes the draws
+std::uint64_t _sceneVersion = 0; // bumped every time an object joins the scene or its mesh is replaced
 VkExtent2D windowExtent = { 1280, 720 };
 VkPhysicalDeviceProperties _gpuProperties{};
 using namespace Concerto;
 using namespace Concerto::Graphics;
 using namespace Concerto::Graphics::Wrapper;
-#define MAX_OBJECTS 1000
+#define MAX_OBJECTS 1000 // range of the object descriptor, the data itself comes from the FrameAllocator
+#define FRAME_ALLOCATOR_SIZE (4 * 1024 * 1024)
+#define LOD_PIXEL_ERROR 1.f
+#define MESH_UPLOAD_BUDGET (16 * 1024 * 1024)
+#define ARENA_VERTEX_CAPACITY (1 << 20)
+#define ARENA_INDEX_CAPACITY (4 << 20)
+#define MEMORY_BUDGET_WARNING 0.9f // share of a heap budget after which the VMA state is dumped
+#define MEMORY_STATS_FILE "memory_stats.json"
+#define DEFRAGMENTATION_THRESHOLD 0.3f // fragmentation of the VMA blocks after which a defragmentation starts
+#define MIN_OBJECTS_PER_RECORDING_THREAD 256
+#define CULL_GROUP_SIZE 64 // local_size_x of cull.comp
+#define MAX_CULL_LODS 8 // MAX_LODS of cull.comp, the coarser levels are not used by the culling shader
 
 struct Material
 {
@@ -83,66 +115,68 @@ struct GPUSceneData
 	glm::vec4 sunlightColor;
 };
 
-std::size_t pad_uniform_buffer_size(size_t originalSize)
+/**
+ * @brief Descriptor sets of the per-frame data, every buffer lives in the FrameAllocator ring and a frame binds
+ * the sets at the dynamic offsets of its own allocations
+ */
+struct SceneDescriptors
 {
-	size_t minUboAlignment = _gpuProperties.limits.minUniformBufferOffsetAlignment;
-	size_t alignedSize = originalSize;
-	if (minUboAlignment > 0)
+	SceneDescriptors(VkDevice device, DescriptorPool& pool, DescriptorSetLayout& globalDescriptorSetLayout,
+			DescriptorSetLayout& objectDescriptorSetLayout, const FrameAllocator& frameAllocator) :
+			globalDescriptor(device, pool, globalDescriptorSetLayout),
+			objectDescriptor(device, pool, objectDescriptorSetLayout)
 	{
-		alignedSize = (alignedSize + minUboAlignment - 1) & ~(minUboAlignment - 1);
-	}
-	return alignedSize;
-}
-
-struct FrameData
-{
-	FrameData(Allocator& allocator, VkDevice device, std::uint32_t queueFamily, DescriptorPool& pool,
-			DescriptorSetLayout& globalDescriptorSetLayout, DescriptorSetLayout& objectDescriptorSetLayout,
-			AllocatedBuffer& sceneParameterBuffer,
-			bool signaled = true) : _presentSemaphore(device),
-									_commandPool(device, queueFamily),
-									_renderSemaphore(device),
-									_renderFence(device, signaled),
-									_mainCommandBuffer(device, _commandPool.get()),
-									_cameraBuffer(makeAllocatedBuffer<GPUCameraData>(allocator,
-											VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-											VMA_MEMORY_USAGE_CPU_TO_GPU)),
-									globalDescriptor(device, pool, globalDescriptorSetLayout),
-									_objectBuffer(makeAllocatedBuffer<GPUObjectData>(allocator, MAX_OBJECTS,
-											VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-											VMA_MEMORY_USAGE_CPU_TO_GPU)),
-									objectDescriptor(device, pool, objectDescriptorSetLayout)
-	{
-
 		VkDescriptorBufferInfo cameraInfo;
-		cameraInfo.buffer = _cameraBuffer._buffer;
+		cameraInfo.buffer = frameAllocator.getBuffer();
 		cameraInfo.offset = 0;
 		cameraInfo.range = sizeof(GPUCameraData);
 
 		VkDescriptorBufferInfo sceneInfo;
-		sceneInfo.buffer = sceneParameterBuffer._buffer;
+		sceneInfo.buffer = frameAllocator.getBuffer();
 		sceneInfo.offset = 0;
 		sceneInfo.range = sizeof(GPUSceneData);
 
 		VkDescriptorBufferInfo objectBufferInfo;
-		objectBufferInfo.buffer = _objectBuffer._buffer;
+		objectBufferInfo.buffer = frameAllocator.getBuffer();
 		objectBufferInfo.offset = 0;
 		objectBufferInfo.range = sizeof(GPUObjectData) * MAX_OBJECTS;
 
-		VkWriteDescriptorSet cameraWrite = VulkanInitializer::WriteDescriptorBuffer(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-				globalDescriptor.get(), &cameraInfo, 0);
+		VkWriteDescriptorSet cameraWrite = VulkanInitializer::WriteDescriptorBuffer(
+				VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, globalDescriptor.get(), &cameraInfo, 0);
 
 		VkWriteDescriptorSet sceneWrite = VulkanInitializer::WriteDescriptorBuffer(
 				VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, globalDescriptor.get(), &sceneInfo, 1);
 
-		VkWriteDescriptorSet objectWrite = VulkanInitializer::WriteDescriptorBuffer(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-				objectDescriptor.get(), &objectBufferInfo, 0);
+		VkWriteDescriptorSet objectWrite = VulkanInitializer::WriteDescriptorBuffer(
+				VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, objectDescriptor.get(), &objectBufferInfo, 0);
 
 		VkWriteDescriptorSet setWrites[] = { cameraWrite, sceneWrite, objectWrite };
 
 		vkUpdateDescriptorSets(device, 3, setWrites, 0, nullptr);
 	}
 
+	DescriptorSet globalDescriptor;
+	DescriptorSet objectDescriptor;
+};
+
+/**
+ * @brief Dynamic offsets of the allocations of a frame in the FrameAllocator ring
+ */
+struct FrameUniforms
+{
+	std::uint32_t globalOffsets[2]; // camera then scene, in binding order
+	std::uint32_t objectOffset;
+};
+
+struct FrameData
+{
+	FrameData(VkDevice device, std::uint32_t queueFamily, bool signaled = true) : _presentSemaphore(device),
+																				   _renderSemaphore(device),
+																				   _renderFence(device, signaled),
+																				   _commandAllocator(device, queueFamily)
+	{
+	}
+
 	FrameData(FrameData&&) = default;
 
 	FrameData() = delete;
@@ -152,14 +186,8 @@ struct FrameData
 	Semaphore _presentSemaphore, _renderSemaphore;
 	Fence _renderFence;
 
-	CommandPool _commandPool;
-	CommandBuffer _mainCommandBuffer;
-
-	AllocatedBuffer _cameraBuffer;
-	DescriptorSet globalDescriptor;
-
-	AllocatedBuffer _objectBuffer;
-	DescriptorSet objectDescriptor;
+	// Reset once the fence of the frame signals, every command buffer of the frame comes from it
+	CommandAllocator _commandAllocator;
 };
 
 using Frames = std::array<FrameData, 2>;
@@ -175,19 +203,176 @@ struct RenderObject
 	std::unique_ptr<Mesh> mesh;
 	Material material;
 	glm::mat4 transformMatrix;
+	std::uint32_t lod = 0;
+	std::vector<IndexRange> visibleRanges;
+	std::string source; // file of the mesh, reloaded when it changes
+	std::filesystem::file_time_type sourceTime;
 };
 
 std::vector<std::unique_ptr<RenderObject>> _renderables;
 
-void drawObjects(CommandBuffer& commandBuffer, AllocatedBuffer& sceneParameterBuffer);
+/**
+ * @brief Mesh being loaded, for a new object or to replace the mesh of an object whose source changed
+ */
+struct PendingMesh
+{
+	std::string file;
+	std::filesystem::file_time_type sourceTime;
+	std::future<std::unique_ptr<Mesh>> mesh;
+	RenderObject* object; // nullptr for a new object
+};
+
+/**
+ * @brief Consecutive VkDrawIndexedIndirectCommand of the objects sharing a pipeline and geometry buffers, the
+ * firstInstance of each command is the index of its object in the object buffer
+ */
+struct IndirectBatch
+{
+	const Material* material;
+	const Mesh* mesh; // any mesh of the batch, they all bind the same buffers
+	VkBuffer buffer;
+	VkDeviceSize offset;
+	std::uint32_t drawCount; // the most commands the batch can hold when countBuffer is set
+	VkBuffer countBuffer; // VK_NULL_HANDLE if the commands are written by the host
+	VkDeviceSize countOffset; // of the uint32_t number of commands written by the culling shader
+};
+
+// Inputs of cull.comp, std430 layout
+struct GPUCullInstance
+{
+	std::uint32_t mesh;
+	std::uint32_t batch;
+	float scale; // largest scale of the object transform, without the position transform of the mesh
+	std::uint32_t pad;
+};
+
+struct GPUMeshLod
+{
+	std::uint32_t firstIndex;
+	std::uint32_t indexCount;
+	float error;
+	std::uint32_t pad;
+};
+
+struct GPUCullMesh
+{
+	glm::vec4 boundingSphere; // center in vertex buffer space, radius in model space
+	std::uint32_t lodCount;
+	std::uint32_t firstIndex;
+	std::int32_t vertexOffset;
+	std::uint32_t pad;
+	GPUMeshLod lods[MAX_CULL_LODS];
+};
+static_assert(sizeof(GPUCullMesh) == 32 + MAX_CULL_LODS * sizeof(GPUMeshLod));
+
+struct GPUCullConstants
+{
+	glm::vec4 frustumPlanes[6]; // world space
+	glm::vec4 cameraPosition; // w is the projection scale
+	std::uint32_t objectCount;
+	float lodPixelError;
+};
+
+std::size_t alignStorage(std::size_t size, const VkPhysicalDeviceLimits& limits)
+{
+	const std::size_t alignment = std::max<std::size_t>(limits.minStorageBufferOffsetAlignment, 1);
+	return (size + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief Buffers and pipeline of cull.comp, which frustum culls the objects, selects their level of detail and
+ * writes their draw commands on the device
+ *
+ * The scene buffer holds one slice per frame in flight with the object matrices and the culling inputs, the draw
+ * buffer one slice per frame in flight with the commands and draw counts the shader writes. A slice is only
+ * rewritten when the scene changed since it was written, a static scene costs no per-object work on the host.
+ */
+struct GPUCulling
+{
+	struct Slice
+	{
+		DescriptorSet descriptor;
+		std::uint64_t sceneVersion; // of the data in the slice
+		VkBuffer drawBuffer; // the descriptor and batches point to, the Defragmenter can move the draw buffer
+		std::uint32_t objectCount;
+		std::vector<IndirectBatch> batches;
+	};
+
+	GPUCulling(VkDevice device, Allocator& allocator, const VkPhysicalDeviceLimits& limits, DescriptorPool& pool,
+			DescriptorSetLayout& objectSetLayout, std::size_t frameCount) :
+			device(device),
+			instancesOffset(alignStorage(MAX_OBJECTS * sizeof(GPUObjectData), limits)),
+			meshesOffset(instancesOffset + alignStorage(MAX_OBJECTS * sizeof(GPUCullInstance), limits)),
+			batchesOffset(meshesOffset + alignStorage(MAX_OBJECTS * sizeof(GPUCullMesh), limits)),
+			sceneSliceSize(batchesOffset + alignStorage(MAX_OBJECTS * sizeof(std::uint32_t), limits)),
+			countsOffset(alignStorage(MAX_OBJECTS * sizeof(VkDrawIndexedIndirectCommand), limits)),
+			drawSliceSize(countsOffset + alignStorage(MAX_OBJECTS * sizeof(std::uint32_t), limits)),
+			setLayout(device, []()
+			{
+				std::vector<VkDescriptorSetLayoutBinding> bindings;
+				for (std::uint32_t binding = 0; binding < 6; binding++)
+					bindings.push_back(VulkanInitializer::DescriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+							VK_SHADER_STAGE_COMPUTE_BIT, binding));
+				return bindings;
+			}()),
+			shader(R"(.\shaders\cull.comp.spv)", device),
+			pipelineLayout(makePipelineLayout<GPUCullConstants>(device, { setLayout }, VK_SHADER_STAGE_COMPUTE_BIT)),
+			pipeline(device, pipelineLayout.get(), shader.getShaderModule()),
+			sceneBuffer(allocator, sceneSliceSize * frameCount, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+					VMA_MEMORY_USAGE_CPU_TO_GPU, VMA_ALLOCATION_CREATE_MAPPED_BIT),
+			drawBuffer(allocator, drawSliceSize * frameCount,
+					VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY),
+			objectDescriptor(device, pool, objectSetLayout)
+	{
+		// Mapped buffers are never moved by the Defragmenter, this descriptor stays valid
+		if (!sceneBuffer.isMapped())
+			throw std::runtime_error("Unable to map the culling scene buffer");
+		VkDescriptorBufferInfo objectBufferInfo;
+		objectBufferInfo.buffer = sceneBuffer._buffer;
+		objectBufferInfo.offset = 0;
+		objectBufferInfo.range = sizeof(GPUObjectData) * MAX_OBJECTS;
+		VkWriteDescriptorSet objectWrite = VulkanInitializer::WriteDescriptorBuffer(
+				VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, objectDescriptor.get(), &objectBufferInfo, 0);
+		vkUpdateDescriptorSets(device, 1, &objectWrite, 0, nullptr);
+		slices.reserve(frameCount);
+		for (std::size_t i = 0; i < frameCount; i++)
+			slices.push_back({ DescriptorSet(device, pool, setLayout), ~std::uint64_t(0), VK_NULL_HANDLE, 0, {} });
+	}
+
+	VkDevice device;
+	// Offsets in a scene slice, the object matrices come first
+	std::size_t instancesOffset;
+	std::size_t meshesOffset;
+	std::size_t batchesOffset; // index of the first command of each batch
+	std::size_t sceneSliceSize;
+	// Offsets in a draw slice, the commands come first
+	std::size_t countsOffset;
+	std::size_t drawSliceSize;
+	DescriptorSetLayout setLayout;
+	ShaderModule shader;
+	PipelineLayout pipelineLayout;
+	ComputePipeline pipeline;
+	AllocatedBuffer sceneBuffer;
+	AllocatedBuffer drawBuffer;
+	DescriptorSet objectDescriptor; // set 1 of the mesh pipelines, at the dynamic offset of the scene slice
+	std::vector<Slice> slices;
+};
 
 void
-draw(Allocator& allocator, Swapchain& swapchain, RenderPass& renderpass, FrameBuffer& frameBuffer,
-		VkQueue _graphicsQueue, FrameData& frame, AllocatedBuffer& sceneParameterBuffer);
+draw(Swapchain& swapchain, RenderPass& renderpass, FrameBuffer& frameBuffer, VkQueue _graphicsQueue,
+		std::size_t frameIndex, FrameData& frame, FrameAllocator& frameAllocator, SceneDescriptors& descriptors,
+		Defragmenter& defragmenter, DeletionQueue& deletionQueue, ParallelRecorder& recorder,
+		const Material& depthPrepassMaterial, GPUCulling* culling);
+
+void checkMemoryBudget(Allocator& allocator);
+
+void reportHostAllocations(HostAllocator& hostAllocator, const char* section);
 
 
 int main()
 {
+	// Installed before the instance, every Vulkan object below hands its host allocations to it
+	HostAllocator hostAllocator;
 	const char* appName = "Concerto";
 	IWindowPtr window = std::make_unique<GlfW3>(appName, windowExtent.width, windowExtent.height);
 
@@ -197,6 +382,7 @@ int main()
 			.request_validation_layers(true)
 			.use_default_debug_messenger()
 			.require_api_version(1, 1, 0)
+			.set_allocation_callbacks(HostAllocator::getCallbacks())
 			.build();
 	auto system_info_ret = vkb::SystemInfo::get_system_info();
 	if (!system_info_ret)
@@ -210,18 +396,29 @@ int main()
 		_builder.enable_validation_layers();
 	}
 	_instance = instance.value().instance;
-	glfwCreateWindowSurface(_instance, (GLFWwindow*)window->getRawWindow(), nullptr, &vkSurface);
+	glfwCreateWindowSurface(_instance, (GLFWwindow*)window->getRawWindow(), HostAllocator::getCallbacks(), &vkSurface);
 	vkb::PhysicalDeviceSelector selector(instance.value());
 	vkb::PhysicalDevice physicalDevice = selector.set_minimum_version(1, 1)
 			.set_surface(vkSurface)
 			.select()
 			.value();
+	const bool memoryBudget = physicalDevice.enable_extension_if_present(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+	// Without them the objects are drawn one by one
+	VkPhysicalDeviceFeatures indirectFeatures = {};
+	indirectFeatures.multiDrawIndirect = VK_TRUE;
+	indirectFeatures.drawIndirectFirstInstance = VK_TRUE;
+	_indirectDraws = physicalDevice.enable_features_if_present(indirectFeatures);
+	// Without it the host culls the objects and writes the draw commands
+	_gpuCulling = _indirectDraws && physicalDevice.enable_extension_if_present(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
 	vkb::DeviceBuilder deviceBuilder(physicalDevice);
 	VkPhysicalDeviceShaderDrawParametersFeatures shader_draw_parameters_features = {};
 	shader_draw_parameters_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_DRAW_PARAMETERS_FEATURES;
 	shader_draw_parameters_features.pNext = nullptr;
 	shader_draw_parameters_features.shaderDrawParameters = VK_TRUE;
-	vkb::Device vkbDevice = deviceBuilder.add_pNext(&shader_draw_parameters_features).build().value();
+	vkb::Device vkbDevice = deviceBuilder.add_pNext(&shader_draw_parameters_features)
+			.set_allocation_callbacks(HostAllocator::getCallbacks())
+			.build()
+			.value();
 	_device = vkbDevice.device;
 	VkPhysicalDevice _physicalDevice = physicalDevice.physical_device;
 	VkQueue _graphicsQueue = vkbDevice.get_queue(vkb::QueueType::graphics).value();
@@ -230,7 +427,7 @@ int main()
 	vkGetPhysicalDeviceProperties(_physicalDevice, &_gpuProperties);
 	std::cout << "The GPU has  a minimum buffer alignment of : "
 			  << _gpuProperties.limits.minUniformBufferOffsetAlignment << std::endl;
-	Allocator _allocator(_physicalDevice, _device, _instance);
+	Allocator _allocator(_physicalDevice, _device, _instance, memoryBudget);
 	Swapchain swapchain(_allocator, windowExtent, _physicalDevice, _device, vkSurface, _instance);
 
 	// Renderpass
@@ -298,34 +495,46 @@ int main()
 	FrameBuffer frameBuffer(_device, swapchain, renderPass);
 	// Commands
 	VkDescriptorSetLayoutBinding camBufferBind = VulkanInitializer::DescriptorSetLayoutBinding(
-			VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,VK_SHADER_STAGE_VERTEX_BIT,0);
+			VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,VK_SHADER_STAGE_VERTEX_BIT,0);
 	VkDescriptorSetLayoutBinding sceneBind = VulkanInitializer::DescriptorSetLayoutBinding(
 			VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 1);
 	VkDescriptorSetLayoutBinding objectBind = VulkanInitializer::DescriptorSetLayoutBinding(
-			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, 0);
+			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, VK_SHADER_STAGE_VERTEX_BIT, 0);
 	DescriptorSetLayout globalSetLayout(_device, { camBufferBind, sceneBind });
 	DescriptorSetLayout objectSetLayout(_device, { objectBind });
 
 	std::vector<VkDescriptorPoolSize> sizes =
 			{
-					{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,         10 },
 					{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 10 },
-					{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         10 }
+					{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 10 },
+					{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 12 }
 			};
 	DescriptorPool descriptorPool(_device, sizes);
-	const std::size_t sceneParamBufferSize = 2 * pad_uniform_buffer_size(sizeof(GPUSceneData));
-	AllocatedBuffer _sceneParameterBuffer(_allocator, sceneParamBufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-			VMA_MEMORY_USAGE_CPU_TO_GPU);
 	Frames frames = {
-			FrameData(_allocator, _device, _graphicsQueueFamily, descriptorPool, globalSetLayout, objectSetLayout,
-					_sceneParameterBuffer, true),
-			FrameData(_allocator, _device, _graphicsQueueFamily, descriptorPool, globalSetLayout, objectSetLayout,
-					_sceneParameterBuffer, true)
+			FrameData(_device, _graphicsQueueFamily, true),
+			FrameData(_device, _graphicsQueueFamily, true)
 	};
+	FrameAllocator frameAllocator(_allocator, _gpuProperties.limits, frames.size(), FRAME_ALLOCATOR_SIZE,
+			MAX_OBJECTS * sizeof(GPUObjectData));
+	SceneDescriptors sceneDescriptors(_device, descriptorPool, globalSetLayout, objectSetLayout, frameAllocator);
+	ParallelRecorder recorder(_device, _graphicsQueueFamily, frames.size(), 0, MIN_OBJECTS_PER_RECORDING_THREAD);
 	// Commands
 	// Pilpline
+	hostAllocator.resetCounters();
+	MeshLoadOptions meshLoadOptions;
+	meshLoadOptions.optimize = true;
+	meshLoadOptions.vertexFormat = VertexFormat::Split;
+	meshLoadOptions.buildMeshlets = true;
+	meshLoadOptions.lodCount = 4;
+	const bool packedVertices = meshLoadOptions.vertexFormat == VertexFormat::Packed;
 	ShaderModule triangleFragShader(R"(.\shaders\default_lit.frag.spv)", _device);
-	ShaderModule triangleVertexShader(R"(.\shaders\tri_mesh_descriptors.vert.spv)", _device);
+	// The indirect shaders read the model matrices from the object buffer at gl_BaseInstance
+	const char* vertexShaderPath = _indirectDraws
+								   ? (packedVertices ? R"(.\shaders\tri_mesh_indirect_packed.vert.spv)"
+													 : R"(.\shaders\tri_mesh_indirect.vert.spv)")
+								   : (packedVertices ? R"(.\shaders\tri_mesh_descriptors_packed.vert.spv)"
+													 : R"(.\shaders\tri_mesh_descriptors.vert.spv)");
+	ShaderModule triangleVertexShader(vertexShaderPath, _device);
 	PipelineLayout meshPipelineLayout = makePipelineLayout<MeshPushConstants>(_device, { globalSetLayout, objectSetLayout });
 
 	PipelineInfo pipelineInfo;
@@ -337,7 +546,7 @@ int main()
 			VulkanInitializer::PipelineShaderStageCreateInfo(VK_SHADER_STAGE_FRAGMENT_BIT,
 					triangleFragShader.getShaderModule()));
 
-	VertexInputDescription vertexDescription = Vertex::getVertexDescription();
+	VertexInputDescription vertexDescription = getVertexDescription(meshLoadOptions.vertexFormat);
 	pipelineInfo._vertexInputInfo = VulkanInitializer::VertexInputStateCreateInfo();
 	pipelineInfo._vertexInputInfo.pVertexAttributeDescriptions = vertexDescription.attributes.data();
 	pipelineInfo._vertexInputInfo.vertexAttributeDescriptionCount = vertexDescription.attributes.size();
@@ -353,6 +562,9 @@ int main()
 	pipelineInfo._scissor.offset = { 0, 0 };
 	pipelineInfo._scissor.extent = windowExtent;
 	pipelineInfo._rasterizer = VulkanInitializer::RasterizationStateCreateInfo(VK_POLYGON_MODE_FILL);
+	// Same back faces as the meshlet cone test: the meshes are counter-clockwise and the flipped projection keeps it
+	pipelineInfo._rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
+	pipelineInfo._rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
 	pipelineInfo._multisampling = VulkanInitializer::MultisamplingStateCreateInfo();
 	pipelineInfo._colorBlendAttachment = VulkanInitializer::ColorBlendAttachmentState();
 	pipelineInfo._pipelineLayout = meshPipelineLayout.get();
@@ -360,28 +572,109 @@ int main()
 
 	Pipeline _meshPipeline(_device, pipelineInfo);
 	_meshPipeline.buildPipeline(renderPass.get()); //TODO RAII
+
+	// Depth prepass, only fetches the positions stream of split meshes
+	ShaderModule depthOnlyVertexShader(_indirectDraws ? R"(.\shaders\depth_only_indirect.vert.spv)"
+													  : R"(.\shaders\depth_only.vert.spv)", _device);
+	PipelineInfo depthPipelineInfo = pipelineInfo;
+	depthPipelineInfo._shaderStages = { VulkanInitializer::PipelineShaderStageCreateInfo(VK_SHADER_STAGE_VERTEX_BIT,
+			depthOnlyVertexShader.getShaderModule()) };
+	VertexInputDescription positionDescription = Vertex::getPositionVertexDescription();
+	depthPipelineInfo._vertexInputInfo.pVertexAttributeDescriptions = positionDescription.attributes.data();
+	depthPipelineInfo._vertexInputInfo.vertexAttributeDescriptionCount = positionDescription.attributes.size();
+	depthPipelineInfo._vertexInputInfo.pVertexBindingDescriptions = positionDescription.bindings.data();
+	depthPipelineInfo._vertexInputInfo.vertexBindingDescriptionCount = positionDescription.bindings.size();
+	depthPipelineInfo._colorBlendAttachment.colorWriteMask = 0;
+
+	Pipeline _depthPipeline(_device, depthPipelineInfo);
+	_depthPipeline.buildPipeline(renderPass.get());
+	Material depthPrepassMaterial(meshPipelineLayout.get(), _depthPipeline.get());
+	std::optional<GPUCulling> culling;
+	if (_gpuCulling)
+		culling.emplace(_device, _allocator, _gpuProperties.limits, descriptorPool, objectSetLayout, frames.size());
+	reportHostAllocations(hostAllocator, "pipeline creation");
 	// Render loop
 
 	Semaphore _presentSemaphore(_device);
 	Semaphore _renderSemaphore(_device);
 	Fence _renderFence(_device);
-	std::unique_ptr<Mesh> monkeyMesh = std::make_unique<Mesh>(".\\assets\\monkey_flat.obj", _allocator,
-			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-			VMA_MEMORY_USAGE_CPU_TO_GPU);
-	_renderables.emplace_back(
-			std::make_unique<RenderObject>(std::move(monkeyMesh), meshPipelineLayout.get(), _meshPipeline.get()));
+	UploadContext uploadContext(_allocator, _device, _graphicsQueue, _graphicsQueueFamily);
+	GeometryArena geometryArena(_allocator, meshLoadOptions.vertexFormat, ARENA_VERTEX_CAPACITY,
+			ARENA_INDEX_CAPACITY);
+	MeshLoader meshLoader(uploadContext);
+	std::vector<PendingMesh> pendingMeshes;
+	auto loadMesh = [&](const std::string& file, RenderObject* object)
+	{
+		std::error_code error;
+		pendingMeshes.push_back({ file, std::filesystem::last_write_time(file, error),
+								  meshLoader.loadAsync(file, geometryArena, meshLoadOptions), object });
+	};
+	loadMesh(".\\assets\\monkey_flat.obj", nullptr);
+	// Declared after the arena and the allocator so what it still holds goes before them
+	DeletionQueue deletionQueue(frames.size());
+	Defragmenter defragmenter(_allocator, deletionQueue);
 
 	while (true)
 	{
 		window->popEvent();
-		draw(_allocator, swapchain, renderPass, frameBuffer, _graphicsQueue, frames[_frameNumber % frames.size()],
-				_sceneParameterBuffer);
+		if (_frameNumber % 1000 == 0)
+		{
+			for (auto& object : _renderables)
+			{
+				std::error_code error;
+				auto sourceTime = std::filesystem::last_write_time(object->source, error);
+				if (error || sourceTime == object->sourceTime)
+					continue;
+				object->sourceTime = sourceTime;
+				loadMesh(object->source, object.get());
+			}
+		}
+		// Objects join the scene as soon as their mesh is uploaded
+		meshLoader.update(MESH_UPLOAD_BUDGET);
+		std::erase_if(pendingMeshes, [&](PendingMesh& pendingMesh)
+		{
+			if (pendingMesh.mesh.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+				return false;
+			try
+			{
+				std::unique_ptr<Mesh> mesh = pendingMesh.mesh.get();
+				if (pendingMesh.object != nullptr)
+				{
+					// The frames in flight may still draw the old mesh, its buffers and arena ranges wait for them
+					deletionQueue.retire(std::exchange(pendingMesh.object->mesh, std::move(mesh)));
+					std::cout << "Mesh: reloaded " << pendingMesh.file << std::endl;
+				}
+				else
+				{
+					auto& object = _renderables.emplace_back(std::make_unique<RenderObject>(std::move(mesh),
+							meshPipelineLayout.get(), _meshPipeline.get()));
+					object->source = pendingMesh.file;
+					object->sourceTime = pendingMesh.sourceTime;
+				}
+				++_sceneVersion;
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << e.what() << std::endl;
+			}
+			return true;
+		});
+		_allocator.setCurrentFrameIndex(_frameNumber);
+		checkMemoryBudget(_allocator);
+		if (_frameNumber % 1000 == 0)
+			reportHostAllocations(hostAllocator, "the last 1000 frames");
+		if (_frameNumber % 1000 == 0 && !defragmenter.isRunning() &&
+			_allocator.getStatistics().fragmentation > DEFRAGMENTATION_THRESHOLD)
+			defragmenter.start();
+		const std::size_t frameIndex = _frameNumber % frames.size();
+		draw(swapchain, renderPass, frameBuffer, _graphicsQueue, frameIndex, frames[frameIndex], frameAllocator,
+				sceneDescriptors, defragmenter, deletionQueue, recorder, depthPrepassMaterial,
+				culling.has_value() ? &culling.value() : nullptr);
 	}
 	// Render loop
 }
 
-void
-drawObjects(Allocator& allocator, CommandBuffer& commandBuffer, FrameData& frame, AllocatedBuffer& sceneParameterBuffer)
+GPUCameraData makeCameraData()
 {
 	glm::vec3 camPos = { 0.f,-6.f,-10.f };
 
@@ -389,84 +682,490 @@ drawObjects(Allocator& allocator, CommandBuffer& commandBuffer, FrameData& frame
 	glm::mat4 projection = glm::perspective(glm::radians(70.f), 1700.f / 900.f, 0.1f, 200.0f);
 	projection[1][1] *= -1;
 
-	Mesh* lastMesh = nullptr;
-	Material* lastMaterial = nullptr;
-
 	GPUCameraData camData{};
 	camData.proj = projection;
 	camData.view = view;
 	camData.viewproj = projection * view;
-	static GPUSceneData _sceneParameters;
-
-	void* data;
-	vmaMapMemory(allocator._allocator, frame._cameraBuffer._allocation, &data);
+	return camData;
+}
 
-	std::memcpy(data, &camData, sizeof(GPUCameraData));
+std::uint32_t selectLod(const Mesh& mesh, const glm::mat4& transformMatrix, const glm::vec3& cameraPosition,
+		float projectionScale)
+{
+	float scale = std::max({ glm::length(glm::vec3(transformMatrix[0])), glm::length(glm::vec3(transformMatrix[1])),
+							 glm::length(glm::vec3(transformMatrix[2])) });
+	glm::vec3 center = glm::vec3(transformMatrix * glm::vec4(mesh._boundingSphere.center, 1.f));
+	float radius = mesh._boundingSphere.radius * scale;
+	float distance = std::max(glm::distance(center, cameraPosition) - radius, 0.1f);
+	// Coarsest level whose error, a model space distance (see MeshLod::error), projected at the closest point of
+	// the bounds stays under LOD_PIXEL_ERROR
+	std::uint32_t lod = 0;
+	for (std::uint32_t i = 1; i < mesh._lods.size(); ++i)
+	{
+		if (mesh._lods[i].error * scale / distance * projectionScale > LOD_PIXEL_ERROR)
+			break;
+		lod = i;
+	}
+	return lod;
+}
 
-	vmaUnmapMemory(allocator._allocator, frame._cameraBuffer._allocation);
+void cullRenderables(const GPUCameraData& camData)
+{
+	glm::vec3 cameraPosition = glm::vec3(glm::inverse(camData.view)[3]);
+	float projectionScale = std::abs(camData.proj[1][1]) * windowExtent.height * 0.5f;
+	Frustum worldFrustum = extractFrustum(camData.viewproj);
+	MeshletCullingStatistics total{};
+	for (auto& object : _renderables)
+	{
+		object->visibleRanges.clear();
+		object->lod = selectLod(*object->mesh, object->transformMatrix, cameraPosition, projectionScale);
+		const MeshLod& lod = object->mesh->_lods[object->lod];
+		float scale = std::max({ glm::length(glm::vec3(object->transformMatrix[0])),
+								 glm::length(glm::vec3(object->transformMatrix[1])),
+								 glm::length(glm::vec3(object->transformMatrix[2])) });
+		BoundingSphere worldSphere{ glm::vec3(object->transformMatrix * glm::vec4(object->mesh->_boundingSphere.center, 1.f)),
+									object->mesh->_boundingSphere.radius * scale };
+		if (!intersects(worldFrustum, worldSphere))
+		{
+			total.frustumCulledTriangles += lod.indexCount / 3;
+			continue;
+		}
+		if (object->lod != 0 || object->mesh->_meshlets.empty())
+		{
+			object->visibleRanges.push_back({ lod.firstIndex, lod.indexCount });
+			continue;
+		}
+		// Meshlet bounds are in model space, bring the frustum and the camera there
+		Frustum frustum = extractFrustum(camData.viewproj * object->transformMatrix);
+		glm::vec3 localCameraPosition = glm::vec3(glm::inverse(object->transformMatrix) * glm::vec4(cameraPosition, 1.f));
+		MeshletCullingStatistics statistics = cullMeshlets(object->mesh->_meshlets, frustum, localCameraPosition,
+				object->visibleRanges);
+		total.visibleTriangles += statistics.visibleTriangles;
+		total.frustumCulledTriangles += statistics.frustumCulledTriangles;
+		total.backfaceCulledTriangles += statistics.backfaceCulledTriangles;
+	}
+	if (_frameNumber % 1000 == 0)
+		std::cout << "Meshlet culling: " << total.visibleTriangles << " triangles visible, "
+				  << total.frustumCulledTriangles << " outside of the frustum, " << total.backfaceCulledTriangles
+				  << " back facing" << std::endl;
+}
 
-	float framed = (_frameNumber / 120.f);
+void checkMemoryBudget(Allocator& allocator)
+{
+	// Dumped once each time a heap goes over the threshold, to see what filled it before something fails
+	static bool overBudget = false;
+	bool over = false;
+	for (const MemoryHeapStatistics& heap : allocator.getHeapBudgets())
+		over = over || static_cast<float>(heap.usage) > static_cast<float>(heap.budget) * MEMORY_BUDGET_WARNING;
+	if (over && !overBudget)
+	{
+		std::cerr << "GPU memory: a heap is over " << MEMORY_BUDGET_WARNING * 100.f << "% of its budget, writing "
+				  << MEMORY_STATS_FILE << std::endl;
+		allocator.writeStatsFile(MEMORY_STATS_FILE);
+	}
+	overBudget = over;
+	if (_frameNumber % 1000 != 0)
+		return;
+	MemoryStatistics statistics = allocator.getStatistics();
+	for (std::size_t i = 0; i < statistics.heaps.size(); ++i)
+	{
+		const MemoryHeapStatistics& heap = statistics.heaps[i];
+		std::cout << "GPU memory heap " << i << (heap.deviceLocal ? " (device local): " : ": ")
+				  << heap.usage / (1024 * 1024) << " / " << heap.budget / (1024 * 1024) << " MiB, "
+				  << heap.allocationCount << " allocations in " << heap.blockCount << " blocks" << std::endl;
+	}
+	for (std::size_t i = 0; i < statistics.tags.size(); ++i)
+	{
+		if (statistics.tags[i].allocationCount == 0)
+			continue;
+		std::cout << "GPU memory " << getMemoryTagName(static_cast<MemoryTag>(i)) << ": "
+				  << statistics.tags[i].allocationCount << " allocations, " << statistics.tags[i].bytes / 1024
+				  << " KiB" << std::endl;
+	}
+	std::cout << "GPU memory fragmentation: " << statistics.fragmentation << " (" << statistics.unusedRangeCount
+			  << " free ranges, " << statistics.unusedBytes / 1024 << " KiB)" << std::endl;
+}
 
-	_sceneParameters.ambientColor = { sin(framed), 0, cos(framed), 1 };
+void reportHostAllocations(HostAllocator& hostAllocator, const char* section)
+{
+	const auto statistics = hostAllocator.getStatistics();
+	for (std::size_t i = 0; i < statistics.size(); ++i)
+	{
+		const HostAllocator::ScopeStatistics& scope = statistics[i];
+		if (scope.allocationCount == 0 && scope.reallocationCount == 0 && scope.freeCount == 0)
+			continue;
+		std::cout << "Driver host allocations during " << section << ", "
+				  << HostAllocator::getScopeName(static_cast<VkSystemAllocationScope>(i)) << " scope: "
+				  << scope.allocationCount << " allocations (" << scope.arenaAllocationCount << " from the arenas), "
+				  << scope.reallocationCount << " reallocations, " << scope.freeCount << " frees, "
+				  << scope.bytes / 1024 << " KiB live, " << scope.peakBytes / 1024 << " KiB peak" << std::endl;
+	}
+	hostAllocator.resetCounters();
+}
 
-	char* sceneData;
-	vmaMapMemory(allocator._allocator, sceneParameterBuffer._allocation, (void**)&sceneData);
+void drawVisibleRanges(CommandBuffer& commandBuffer, const RenderObject& object, std::uint32_t firstInstance)
+{
+	const std::uint32_t firstIndex = object.mesh->getFirstIndex();
+	const std::int32_t vertexOffset = object.mesh->getVertexOffset();
+	for (const IndexRange& range : object.visibleRanges)
+		commandBuffer.drawIndexed(range.indexCount, 1, firstIndex + range.firstIndex, vertexOffset, firstInstance);
+}
 
-	int frameIndex = _frameNumber % 2;
+/**
+ * @return The number of objects to draw, the object descriptor range only covers the first MAX_OBJECTS ones
+ */
+std::size_t getDrawnObjectCount()
+{
+	static std::size_t reportedCount = 0;
+	if (_renderables.size() > MAX_OBJECTS && _renderables.size() != reportedCount)
+	{
+		std::cerr << "Scene: " << _renderables.size() << " objects, only the first " << MAX_OBJECTS
+				  << " are drawn" << std::endl;
+		reportedCount = _renderables.size();
+	}
+	return std::min<std::size_t>(_renderables.size(), MAX_OBJECTS);
+}
 
-	sceneData += pad_uniform_buffer_size(sizeof(GPUSceneData)) * frameIndex;
+/**
+ * @param writeObjects false if the object matrices come from the GPUCulling scene buffer, objectOffset is then 0
+ */
+FrameUniforms writeFrameUniforms(FrameAllocator& frameAllocator, const GPUCameraData& camData, bool writeObjects)
+{
+	static GPUSceneData _sceneParameters;
 
-	std::memcpy(sceneData, &_sceneParameters, sizeof(GPUSceneData));
+	float framed = (_frameNumber / 120.f);
 
-	vmaUnmapMemory(allocator._allocator, sceneParameterBuffer._allocation);
+	_sceneParameters.ambientColor = { sin(framed), 0, cos(framed), 1 };
 
+	FrameAllocation camera = frameAllocator.allocateUniform(sizeof(GPUCameraData));
+	camera.as<GPUCameraData>()[0] = camData;
 
-	void* objectData;
-	vmaMapMemory(allocator._allocator, frame._objectBuffer._allocation, &objectData);
+	FrameAllocation scene = frameAllocator.allocateUniform(sizeof(GPUSceneData));
+	scene.as<GPUSceneData>()[0] = _sceneParameters;
+	if (!writeObjects)
+		return { { camera.offset, scene.offset }, 0 };
 
-	auto* objectSSBO = (GPUObjectData*)objectData;
-	for (std::size_t i = 0; i < _renderables.size(); i++)
+	// Indexed by the instance index of the draws
+	const std::size_t objectCount = getDrawnObjectCount();
+	FrameAllocation objects = frameAllocator.allocateStorage(std::max<std::size_t>(objectCount, 1) *
+			sizeof(GPUObjectData));
+	std::span<GPUObjectData> objectSSBO = objects.as<GPUObjectData>(objectCount);
+	for (std::size_t i = 0; i < objectCount; i++)
 	{
-		objectSSBO[i].modelMatrix = _renderables[i]->transformMatrix;
+		objectSSBO[i].modelMatrix = _renderables[i]->transformMatrix * _renderables[i]->mesh->getPositionTransform();
 	}
-	vmaUnmapMemory(allocator._allocator, frame._objectBuffer._allocation);
-	for (std::size_t i = 0; i < _renderables.size(); i++)
+	return { { camera.offset, scene.offset }, objects.offset };
+}
+
+void drawObjects(CommandBuffer& commandBuffer, SceneDescriptors& descriptors, const FrameUniforms& uniforms,
+		std::size_t first, std::size_t last)
+{
+	// The command buffer drops the binds of what is already bound, objects sharing a material or an arena only
+	// bind it once
+	for (std::size_t i = first; i < last; i++)
 	{
 		RenderObject &object = *_renderables[i];
-		if ((int)&object.material != (int)lastMaterial)
-		{
-			std::uint32_t uniform_offset = pad_uniform_buffer_size(sizeof(GPUSceneData)) * frameIndex;
-			commandBuffer.bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, object.material._pipeline);
-			lastMaterial = &object.material;
-			commandBuffer.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, object.material._pipelineLayout, 0, 1,
-					frame.globalDescriptor, uniform_offset);
-			commandBuffer.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, object.material._pipelineLayout, 1, 1,
-					frame.objectDescriptor);
-		}
-		glm::mat4 mesh_matrix = projection * view * object.transformMatrix;
+		commandBuffer.bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, object.material._pipeline);
+		commandBuffer.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, object.material._pipelineLayout, 0, 1,
+				descriptors.globalDescriptor, uniforms.globalOffsets);
+		commandBuffer.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, object.material._pipelineLayout, 1, 1,
+				descriptors.objectDescriptor, uniforms.objectOffset);
 
 		MeshPushConstants constants{};
-		constants.render_matrix = object.transformMatrix;
+		constants.render_matrix = object.transformMatrix * object.mesh->getPositionTransform();
 		commandBuffer.updatePushConstants(object.material._pipelineLayout, constants);
-		if (object.mesh.get() != lastMesh)
-		{
-			commandBuffer.bindVertexBuffers(object.mesh->_vertexBuffer);
-			lastMesh = object.mesh.get();
-		}
-		commandBuffer.draw(object.mesh->_vertices.size(), 1, 0, i);
+		object.mesh->bind(commandBuffer);
+		drawVisibleRanges(commandBuffer, object, i);
+	}
+}
+
+void drawDepthPrepass(CommandBuffer& commandBuffer, SceneDescriptors& descriptors, const FrameUniforms& uniforms,
+		const Material& material, std::size_t first, std::size_t last)
+{
+	commandBuffer.bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, material._pipeline);
+	commandBuffer.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, material._pipelineLayout, 0, 1,
+			descriptors.globalDescriptor, uniforms.globalOffsets);
+	for (std::size_t i = first; i < last; i++)
+	{
+		const auto& object = _renderables[i];
+		if (object->mesh->_vertexFormat != VertexFormat::Split)
+			continue;
+		MeshPushConstants constants{};
+		constants.render_matrix = object->transformMatrix * object->mesh->getPositionTransform();
+		commandBuffer.updatePushConstants(material._pipelineLayout, constants);
+		object->mesh->bindPositions(commandBuffer);
+		drawVisibleRanges(commandBuffer, *object, 0);
+	}
+}
+
+/**
+ * @brief Writes a draw command per visible range of every object in the frame allocator, sorted by pipeline
+ * @return The number of draw commands
+ */
+std::size_t buildIndirectBatches(FrameAllocator& frameAllocator, std::vector<IndirectBatch>& batches)
+{
+	using BatchKey = std::tuple<VkPipeline, VkPipelineLayout, const void*>;
+	static std::map<BatchKey, IndirectBatch> batchMap;
+	static std::vector<IndirectBatch*> objectBatches;
+	const std::size_t objectCount = getDrawnObjectCount();
+	batchMap.clear();
+	objectBatches.resize(objectCount);
+	batches.clear();
+
+	std::size_t drawCount = 0;
+	IndirectBatch* batch = nullptr;
+	for (std::size_t i = 0; i < objectCount; i++)
+	{
+		const RenderObject& object = *_renderables[i];
+		const BatchKey key = { object.material._pipeline, object.material._pipelineLayout,
+							   object.mesh->getGeometryBinding() };
+		// Consecutive objects usually share their batch
+		if (batch == nullptr || batch->material->_pipeline != std::get<0>(key) ||
+			batch->material->_pipelineLayout != std::get<1>(key) || batch->mesh->getGeometryBinding() != std::get<2>(key))
+			batch = &batchMap.try_emplace(key, IndirectBatch{ &object.material, object.mesh.get() }).first->second;
+		batch->drawCount += static_cast<std::uint32_t>(object.visibleRanges.size());
+		objectBatches[i] = batch;
+		drawCount += object.visibleRanges.size();
+	}
+	if (drawCount == 0)
+		return 0;
+
+	FrameAllocation allocation = frameAllocator.allocateIndirect(drawCount * sizeof(VkDrawIndexedIndirectCommand));
+	std::span<VkDrawIndexedIndirectCommand> commands = allocation.as<VkDrawIndexedIndirectCommand>(drawCount);
+	// Until the commands are written, offset is the index of the next command of the batch
+	std::uint32_t firstDraw = 0;
+	for (auto& [key, indirectBatch] : batchMap)
+	{
+		indirectBatch.buffer = allocation.buffer;
+		indirectBatch.offset = firstDraw;
+		firstDraw += indirectBatch.drawCount;
 	}
+	for (std::size_t i = 0; i < objectCount; i++)
+	{
+		const RenderObject& object = *_renderables[i];
+		IndirectBatch& objectBatch = *objectBatches[i];
+		const std::uint32_t firstIndex = object.mesh->getFirstIndex();
+		const std::int32_t vertexOffset = object.mesh->getVertexOffset();
+		for (const IndexRange& range : object.visibleRanges)
+			commands[objectBatch.offset++] = { range.indexCount, 1, firstIndex + range.firstIndex, vertexOffset,
+											   static_cast<std::uint32_t>(i) };
+	}
+	for (auto& [key, indirectBatch] : batchMap)
+	{
+		if (indirectBatch.drawCount == 0)
+			continue;
+		// offset is now past the last command of the batch
+		indirectBatch.offset = allocation.offset +
+							   (indirectBatch.offset - indirectBatch.drawCount) * sizeof(VkDrawIndexedIndirectCommand);
+		batches.push_back(indirectBatch);
+	}
+	return drawCount;
+}
+
+void drawIndirect(CommandBuffer& commandBuffer, const IndirectBatch& batch)
+{
+	// Batches larger than what the device takes in a single call are split
+	const std::uint32_t maxDrawCount = std::max(_gpuProperties.limits.maxDrawIndirectCount, 1u);
+	if (batch.countBuffer != VK_NULL_HANDLE)
+	{
+		// The count is only known on the device, the commands past maxDrawIndirectCount are dropped
+		commandBuffer.drawIndexedIndirectCount(batch.buffer, batch.offset, batch.countBuffer, batch.countOffset,
+				std::min(maxDrawCount, batch.drawCount));
+		return;
+	}
+	for (std::uint32_t first = 0; first < batch.drawCount; first += maxDrawCount)
+		commandBuffer.drawIndexedIndirect(batch.buffer, batch.offset + first * sizeof(VkDrawIndexedIndirectCommand),
+				std::min(maxDrawCount, batch.drawCount - first));
+}
+
+void drawIndirectBatches(CommandBuffer& commandBuffer, SceneDescriptors& descriptors, DescriptorSet& objectDescriptor,
+		const FrameUniforms& uniforms, std::span<const IndirectBatch> batches)
+{
+	for (const IndirectBatch& batch : batches)
+	{
+		commandBuffer.bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, batch.material->_pipeline);
+		commandBuffer.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, batch.material->_pipelineLayout, 0, 1,
+				descriptors.globalDescriptor, uniforms.globalOffsets);
+		commandBuffer.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, batch.material->_pipelineLayout, 1, 1,
+				objectDescriptor, uniforms.objectOffset);
+		batch.mesh->bind(commandBuffer);
+		drawIndirect(commandBuffer, batch);
+	}
+}
+
+void drawIndirectDepthPrepass(CommandBuffer& commandBuffer, SceneDescriptors& descriptors,
+		DescriptorSet& objectDescriptor, const FrameUniforms& uniforms, const Material& material,
+		std::span<const IndirectBatch> batches)
+{
+	commandBuffer.bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, material._pipeline);
+	commandBuffer.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, material._pipelineLayout, 0, 1,
+			descriptors.globalDescriptor, uniforms.globalOffsets);
+	commandBuffer.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, material._pipelineLayout, 1, 1,
+			objectDescriptor, uniforms.objectOffset);
+	for (const IndirectBatch& batch : batches)
+	{
+		if (batch.mesh->_vertexFormat != VertexFormat::Split)
+			continue;
+		batch.mesh->bindPositions(commandBuffer);
+		drawIndirect(commandBuffer, batch);
+	}
+}
+
+/**
+ * @brief Rewrites the culling inputs of the slice of frameIndex and groups the objects in batches, only if the scene
+ * changed since the slice was written or if the draw buffer moved
+ */
+void updateCulling(GPUCulling& culling, std::size_t frameIndex)
+{
+	GPUCulling::Slice& slice = culling.slices[frameIndex];
+	if (slice.sceneVersion == _sceneVersion && slice.drawBuffer == culling.drawBuffer._buffer)
+		return;
+	const std::size_t objectCount = getDrawnObjectCount();
+	std::byte* data = culling.sceneBuffer.getMappedData().data() + frameIndex * culling.sceneSliceSize;
+	auto* objects = reinterpret_cast<GPUObjectData*>(data);
+	auto* instances = reinterpret_cast<GPUCullInstance*>(data + culling.instancesOffset);
+	auto* meshes = reinterpret_cast<GPUCullMesh*>(data + culling.meshesOffset);
+	auto* firstCommands = reinterpret_cast<std::uint32_t*>(data + culling.batchesOffset);
+	const VkDeviceSize drawOffset = frameIndex * culling.drawSliceSize;
+
+	// Same batches as buildIndirectBatches(), each object writes at most one command
+	using BatchKey = std::tuple<VkPipeline, VkPipelineLayout, const void*>;
+	std::map<BatchKey, IndirectBatch> batchMap;
+	for (std::size_t i = 0; i < objectCount; i++)
+	{
+		const RenderObject& object = *_renderables[i];
+		const BatchKey key = { object.material._pipeline, object.material._pipelineLayout,
+							   object.mesh->getGeometryBinding() };
+		batchMap.try_emplace(key, IndirectBatch{ &object.material, object.mesh.get() }).first->second.drawCount++;
+	}
+	std::map<BatchKey, std::uint32_t> batchIndices;
+	slice.batches.clear();
+	std::uint32_t firstCommand = 0;
+	for (auto& [key, batch] : batchMap)
+	{
+		const std::uint32_t batchIndex = static_cast<std::uint32_t>(slice.batches.size());
+		batchIndices[key] = batchIndex;
+		firstCommands[batchIndex] = firstCommand;
+		batch.buffer = culling.drawBuffer._buffer;
+		batch.offset = drawOffset + firstCommand * sizeof(VkDrawIndexedIndirectCommand);
+		batch.countBuffer = culling.drawBuffer._buffer;
+		batch.countOffset = drawOffset + culling.countsOffset + batchIndex * sizeof(std::uint32_t);
+		firstCommand += batch.drawCount;
+		slice.batches.push_back(batch);
+	}
+
+	for (std::size_t i = 0; i < objectCount; i++)
+	{
+		const RenderObject& object = *_renderables[i];
+		const Mesh& mesh = *object.mesh;
+		const glm::mat4 positionTransform = mesh.getPositionTransform();
+		objects[i].modelMatrix = object.transformMatrix * positionTransform;
+		// Every object owns its mesh. The shader brings the center to world space with the object matrix, which
+		// includes the position transform.
+		GPUCullMesh& cullMesh = meshes[i];
+		cullMesh.boundingSphere = glm::vec4(glm::vec3(glm::inverse(positionTransform) *
+													  glm::vec4(mesh._boundingSphere.center, 1.f)),
+				mesh._boundingSphere.radius);
+		cullMesh.lodCount = static_cast<std::uint32_t>(std::min<std::size_t>(mesh._lods.size(), MAX_CULL_LODS));
+		cullMesh.firstIndex = mesh.getFirstIndex();
+		cullMesh.vertexOffset = mesh.getVertexOffset();
+		for (std::uint32_t lod = 0; lod < cullMesh.lodCount; lod++)
+			cullMesh.lods[lod] = { mesh._lods[lod].firstIndex, mesh._lods[lod].indexCount, mesh._lods[lod].error, 0 };
+		const float scale = std::max({ glm::length(glm::vec3(object.transformMatrix[0])),
+									   glm::length(glm::vec3(object.transformMatrix[1])),
+									   glm::length(glm::vec3(object.transformMatrix[2])) });
+		const BatchKey key = { object.material._pipeline, object.material._pipelineLayout,
+							   mesh.getGeometryBinding() };
+		instances[i] = { static_cast<std::uint32_t>(i), batchIndices.at(key), scale, 0 };
+	}
+	culling.sceneBuffer.flush(frameIndex * culling.sceneSliceSize, culling.sceneSliceSize);
+
+	if (slice.drawBuffer != culling.drawBuffer._buffer)
+	{
+		const VkDeviceSize sceneOffset = frameIndex * culling.sceneSliceSize;
+		VkDescriptorBufferInfo bufferInfos[] = {
+				{ culling.sceneBuffer._buffer, sceneOffset, culling.instancesOffset },
+				{ culling.sceneBuffer._buffer, sceneOffset + culling.instancesOffset,
+				  culling.meshesOffset - culling.instancesOffset },
+				{ culling.sceneBuffer._buffer, sceneOffset + culling.meshesOffset,
+				  culling.batchesOffset - culling.meshesOffset },
+				{ culling.sceneBuffer._buffer, sceneOffset + culling.batchesOffset,
+				  culling.sceneSliceSize - culling.batchesOffset },
+				{ culling.drawBuffer._buffer, drawOffset, culling.countsOffset },
+				{ culling.drawBuffer._buffer, drawOffset + culling.countsOffset,
+				  culling.drawSliceSize - culling.countsOffset }
+		};
+		VkWriteDescriptorSet writes[6];
+		for (std::uint32_t binding = 0; binding < 6; binding++)
+			writes[binding] = VulkanInitializer::WriteDescriptorBuffer(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+					slice.descriptor.get(), &bufferInfos[binding], binding);
+		vkUpdateDescriptorSets(culling.device, 6, writes, 0, nullptr);
+		slice.drawBuffer = culling.drawBuffer._buffer;
+	}
+	slice.sceneVersion = _sceneVersion;
+	slice.objectCount = static_cast<std::uint32_t>(objectCount);
+}
+
+/**
+ * @brief Records the culling dispatch of the slice of frameIndex, outside of a render pass and before the draws
+ * reading its commands
+ */
+void recordCulling(CommandBuffer& commandBuffer, GPUCulling& culling, std::size_t frameIndex,
+		const GPUCameraData& camData)
+{
+	GPUCulling::Slice& slice = culling.slices[frameIndex];
+	if (slice.objectCount == 0)
+		return;
+	const VkDeviceSize drawOffset = frameIndex * culling.drawSliceSize;
+	// The shader counts the commands of each batch from zero
+	commandBuffer.fillBuffer(culling.drawBuffer._buffer, drawOffset + culling.countsOffset,
+			slice.batches.size() * sizeof(std::uint32_t), 0);
+	commandBuffer.memoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+	GPUCullConstants constants{};
+	Frustum frustum = extractFrustum(camData.viewproj);
+	std::copy(std::begin(frustum.planes), std::end(frustum.planes), std::begin(constants.frustumPlanes));
+	constants.cameraPosition = glm::vec4(glm::vec3(glm::inverse(camData.view)[3]),
+			std::abs(camData.proj[1][1]) * windowExtent.height * 0.5f);
+	constants.objectCount = slice.objectCount;
+	constants.lodPixelError = LOD_PIXEL_ERROR;
+	commandBuffer.bindPipeline(VK_PIPELINE_BIND_POINT_COMPUTE, culling.pipeline.get());
+	commandBuffer.bindDescriptorSets(VK_PIPELINE_BIND_POINT_COMPUTE, culling.pipelineLayout.get(), 0, 1,
+			slice.descriptor);
+	commandBuffer.pushConstants(culling.pipelineLayout.get(), VK_SHADER_STAGE_COMPUTE_BIT, &constants,
+			sizeof(GPUCullConstants));
+	commandBuffer.dispatch((slice.objectCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE);
+	commandBuffer.memoryBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
 }
 
 void
-draw(Allocator& allocator, Swapchain& swapchain, RenderPass& renderpass, FrameBuffer& frameBuffer,
-		VkQueue _graphicsQueue, FrameData& frame, AllocatedBuffer& sceneParameterBuffer)
+draw(Swapchain& swapchain, RenderPass& renderpass, FrameBuffer& frameBuffer, VkQueue _graphicsQueue,
+		std::size_t frameIndex, FrameData& frame, FrameAllocator& frameAllocator, SceneDescriptors& descriptors,
+		Defragmenter& defragmenter, DeletionQueue& deletionQueue, ParallelRecorder& recorder,
+		const Material& depthPrepassMaterial, GPUCulling* culling)
 {
 	frame._renderFence.wait(1000000000);
 	frame._renderFence.reset();
+	deletionQueue.beginFrame();
+	recorder.beginFrame(frameIndex);
+	frameAllocator.beginFrame(frameIndex);
 	std::uint32_t swapchainImageIndex = swapchain.acquireNextImage(frame._presentSemaphore, frame._renderFence,
 			1000000000);
-	frame._mainCommandBuffer.reset();
-	frame._mainCommandBuffer.begin();
+	// The previous submission of the frame is done, its command buffers all go back at once
+	frame._commandAllocator.reset();
+	CommandBuffer& commandBuffer = frame._commandAllocator.allocate();
+	commandBuffer.begin();
+	// The moved buffers are patched here, before anything of the frame binds them
+	if (defragmenter.update(commandBuffer))
+	{
+		const Defragmenter::Statistics& statistics = defragmenter.getStatistics();
+		std::cout << "Defragmentation: " << statistics.allocationsMoved << " allocations moved ("
+				  << statistics.bytesMoved / 1024 << " KiB) in " << statistics.passCount << " passes, "
+				  << statistics.bytesFreed / 1024 << " KiB and " << statistics.blocksFreed << " blocks freed, "
+				  << statistics.time * 1000.0 << " ms" << std::endl;
+	}
 	VkClearValue clearValue;
 	VkClearValue depthClear;
 	float flash = std::abs(std::sin(_frameNumber / 120.f));
@@ -477,16 +1176,85 @@ draw(Allocator& allocator, Swapchain& swapchain, RenderPass& renderpass, FrameBu
 			frameBuffer[swapchainImageIndex]);
 	rpInfo.clearValueCount = 2;
 	rpInfo.pClearValues = &clearValues[0];
-	frame._mainCommandBuffer.beginRenderPass(rpInfo);
-	drawObjects(allocator, frame._mainCommandBuffer, frame, sceneParameterBuffer);
-	frame._mainCommandBuffer.endRenderPass();
-	frame._mainCommandBuffer.end();
+	GPUCameraData camData = makeCameraData();
+	if (culling == nullptr)
+		cullRenderables(camData);
+	FrameUniforms uniforms = writeFrameUniforms(frameAllocator, camData, culling == nullptr);
+	static std::vector<IndirectBatch> batches;
+	std::size_t indirectDrawCount = _indirectDraws && culling == nullptr ? buildIndirectBatches(frameAllocator, batches)
+																		 : 0;
+	frameAllocator.flush();
+	if (culling != nullptr)
+	{
+		// After the Defragmenter update, which may have moved the draw buffer
+		updateCulling(*culling, frameIndex);
+		uniforms.objectOffset = static_cast<std::uint32_t>(frameIndex * culling->sceneSliceSize);
+		recordCulling(commandBuffer, *culling, frameIndex, camData);
+	}
+	// The subpass is only made of secondary command buffers, the objects are split across the recording threads
+	auto recordStart = std::chrono::steady_clock::now();
+	commandBuffer.beginRenderPass(rpInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+	VkCommandBufferInheritanceInfo inheritanceInfo = VulkanInitializer::CommandBufferInheritanceInfo(renderpass.get(),
+			0, frameBuffer[swapchainImageIndex]);
+	if (culling != nullptr)
+	{
+		std::span<const IndirectBatch> culledBatches = culling->slices[frameIndex].batches;
+		recorder.record(commandBuffer, inheritanceInfo, 1, [&](CommandBuffer& secondary, std::size_t, std::size_t)
+		{
+			drawIndirectDepthPrepass(secondary, descriptors, culling->objectDescriptor, uniforms,
+					depthPrepassMaterial, culledBatches);
+			drawIndirectBatches(secondary, descriptors, culling->objectDescriptor, uniforms, culledBatches);
+		});
+	}
+	else if (_indirectDraws)
+	{
+		// A handful of commands whatever the number of objects, recorded on the calling thread
+		recorder.record(commandBuffer, inheritanceInfo, 1, [&](CommandBuffer& secondary, std::size_t, std::size_t)
+		{
+			drawIndirectDepthPrepass(secondary, descriptors, descriptors.objectDescriptor, uniforms,
+					depthPrepassMaterial, batches);
+			drawIndirectBatches(secondary, descriptors, descriptors.objectDescriptor, uniforms, batches);
+		});
+	}
+	else
+	{
+		recorder.record(commandBuffer, inheritanceInfo, getDrawnObjectCount(),
+				[&](CommandBuffer& secondary, std::size_t first, std::size_t last)
+				{
+					drawDepthPrepass(secondary, descriptors, uniforms, depthPrepassMaterial, first, last);
+				});
+		recorder.record(commandBuffer, inheritanceInfo, getDrawnObjectCount(),
+				[&](CommandBuffer& secondary, std::size_t first, std::size_t last)
+				{
+					drawObjects(secondary, descriptors, uniforms, first, last);
+				});
+	}
+	commandBuffer.endRenderPass();
+	if (_frameNumber % 1000 == 0)
+	{
+		std::cout << "Recorded " << _renderables.size() << " objects on " << recorder.getThreadCount()
+				  << " threads in " << std::chrono::duration<double, std::milli>(
+						  std::chrono::steady_clock::now() - recordStart).count() << " ms" << std::endl;
+		if (culling != nullptr)
+			std::cout << "GPU culling: " << culling->slices[frameIndex].objectCount << " objects in "
+					  << culling->slices[frameIndex].batches.size() << " batches" << std::endl;
+		else if (_indirectDraws)
+			std::cout << "Indirect draws: " << indirectDrawCount << " commands in " << batches.size() << " batches"
+					  << std::endl;
+		StateStatistics stateStatistics = recorder.getStateStatistics();
+		addStateStatistics(stateStatistics, commandBuffer.getStateStatistics());
+		for (std::size_t i = 0; i < stateStatistics.size(); ++i)
+			std::cout << "State commands, " << getStateCommandName(static_cast<StateCommand>(i)) << ": "
+					  << stateStatistics[i].issued << " issued, " << stateStatistics[i].elided << " elided"
+					  << std::endl;
+	}
+	commandBuffer.end();
 
 	VkSubmitInfo submit = {};
 	VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 	auto vkPresentSemaphore = frame._presentSemaphore.get();
 	auto vkRenderSemaphore = frame._renderSemaphore.get();
-	auto vkCommandBuffer = frame._mainCommandBuffer.get();
+	auto vkCommandBuffer = commandBuffer.get();
 
 	submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 	submit.pNext = nullptr;
@@ -4,34 +4,89 @@
 
 #include "wrapper/AllocatedBuffer.hpp"
 #include <stdexcept>
+#include <utility>
 
 namespace Concerto::Graphics::Wrapper
 {
 
 	AllocatedBuffer::AllocatedBuffer(Allocator& allocator,
-			std::size_t allocSize, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage) : _allocator(allocator)
+			std::size_t allocSize, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage,
+			VmaAllocationCreateFlags allocationFlags) : _allocator(allocator), _size(allocSize), _mappedData(nullptr),
+															   _usage(usage),
+															   _tag(getMemoryTag(usage))
 	{
+		if (memoryUsage == VMA_MEMORY_USAGE_GPU_ONLY)
+			_usage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 		VkBufferCreateInfo bufferInfo = {};
 		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 		bufferInfo.pNext = nullptr;
 
 		bufferInfo.size = allocSize;
-		bufferInfo.usage = usage;
+		bufferInfo.usage = _usage;
 
 		VmaAllocationCreateInfo vmaAllocInfo = {};
 		vmaAllocInfo.usage = memoryUsage;
+		vmaAllocInfo.flags = allocationFlags;
+		// Lets the Defragmenter find the buffer to patch when it moves the allocation
+		vmaAllocInfo.pUserData = this;
 
-		if (vmaCreateBuffer(allocator._allocator, &bufferInfo, &vmaAllocInfo, &_buffer, &_allocation, nullptr) !=
+		VmaAllocationInfo allocationInfo = {};
+		if (vmaCreateBuffer(allocator._allocator, &bufferInfo, &vmaAllocInfo, &_buffer, &_allocation, &allocationInfo) !=
 			VK_SUCCESS)
 		{
 			throw std::runtime_error("Failed to allocate command buffer");
 		}
+		// Stays null when the memory type is not host visible, VMA ignores the mapped bit there
+		_mappedData = allocationInfo.pMappedData;
+		_allocator.trackAllocation(_tag, _size);
+	}
+
+	AllocatedBuffer::AllocatedBuffer(AllocatedBuffer&& other) noexcept : _allocator(other._allocator),
+																		 _buffer(std::exchange(other._buffer, VK_NULL_HANDLE)),
+																		 _allocation(std::exchange(other._allocation, VK_NULL_HANDLE)),
+																		 _size(std::exchange(other._size, 0)),
+																		 _mappedData(std::exchange(other._mappedData, nullptr)),
+																		 _usage(other._usage),
+																		 _tag(other._tag)
+	{
+		if (_allocation != VK_NULL_HANDLE)
+			vmaSetAllocationUserData(_allocator._allocator, _allocation, this);
 	}
 
 	AllocatedBuffer::~AllocatedBuffer()
 	{
-		vmaDestroyBuffer(_allocator._allocator, _buffer, _allocation);
+		if (_buffer == VK_NULL_HANDLE)
+			return;
+		_allocator.destroyBuffer(_buffer, _allocation);
+		_allocator.untrackAllocation(_tag, _size);
 		_buffer = VK_NULL_HANDLE;
-		std::cout << "AllocatedBuffer dead" << std::endl;
 	}
-}
\ No newline at end of file
+
+	bool AllocatedBuffer::isMapped() const
+	{
+		return _mappedData != nullptr;
+	}
+
+	void AllocatedBuffer::flush(VkDeviceSize offset, VkDeviceSize size) const
+	{
+		// VMA rounds the range to nonCoherentAtomSize and skips coherent memory types
+		if (vmaFlushAllocation(_allocator._allocator, _allocation, offset, size) != VK_SUCCESS)
+			throw std::runtime_error("Failed to flush buffer");
+	}
+
+	void AllocatedBuffer::invalidate(VkDeviceSize offset, VkDeviceSize size) const
+	{
+		if (vmaInvalidateAllocation(_allocator._allocator, _allocation, offset, size) != VK_SUCCESS)
+			throw std::runtime_error("Failed to invalidate buffer");
+	}
+
+	std::size_t AllocatedBuffer::getSize() const
+	{
+		return _size;
+	}
+
+	VkBufferUsageFlags AllocatedBuffer::getUsage() const
+	{
+		return _usage;
+	}
+}
@@ -3,25 +3,213 @@
 //
 
 #include "wrapper/Allocator.hpp"
+#include "wrapper/Defragmenter.hpp"
+#include "wrapper/HostAllocator.hpp"
+#include <algorithm>
 #include <assert.h>
+#include <fstream>
 #include <stdexcept>
 namespace Concerto::Graphics::Wrapper
 {
-	Allocator::Allocator(VkPhysicalDevice physicalDevice, VkDevice device, VkInstance instance) : _allocator(VK_NULL_HANDLE)
+	namespace
+	{
+		constexpr VkDeviceSize UniformBlockSize = 2 * 1024 * 1024;
+		constexpr VkDeviceSize StorageBlockSize = 8 * 1024 * 1024;
+		constexpr VkDeviceSize GeometryBlockSize = 32 * 1024 * 1024;
+		constexpr VkDeviceSize StagingBlockSize = 16 * 1024 * 1024;
+		// Keeps vertex, index and copy offsets aligned for every vertex attribute format
+		constexpr VkDeviceSize MinBufferAlignment = 16;
+	}
+
+	MemoryTag getMemoryTag(VkBufferUsageFlags usage)
+	{
+		if (usage & (VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT))
+			return MemoryTag::Geometry;
+		if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+			return MemoryTag::Uniform;
+		if (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+			return MemoryTag::Storage;
+		if (usage & VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
+			return MemoryTag::Staging;
+		return MemoryTag::Other;
+	}
+
+	const char* getMemoryTagName(MemoryTag tag)
+	{
+		switch (tag)
+		{
+		case MemoryTag::Geometry:
+			return "Geometry";
+		case MemoryTag::Uniform:
+			return "Uniform";
+		case MemoryTag::Storage:
+			return "Storage";
+		case MemoryTag::Staging:
+			return "Staging";
+		case MemoryTag::Image:
+			return "Image";
+		default:
+			return "Other";
+		}
+	}
+
+	Allocator::Allocator(VkPhysicalDevice physicalDevice, VkDevice device, VkInstance instance, bool memoryBudget) :
+			_allocator(VK_NULL_HANDLE),
+			_memoryBudget(memoryBudget),
+			_defragmenter(nullptr)
 	{
 		VmaAllocatorCreateInfo allocatorInfo = {};
 		allocatorInfo.physicalDevice = physicalDevice;
 		allocatorInfo.device = device;
 		allocatorInfo.instance = instance;
+		allocatorInfo.pAllocationCallbacks = HostAllocator::getCallbacks();
+		// The budget extension queries the heaps through vkGetPhysicalDeviceMemoryProperties2, core in 1.1
+		allocatorInfo.vulkanApiVersion = VK_API_VERSION_1_1;
+		if (memoryBudget)
+			allocatorInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
 		if (vmaCreateAllocator(&allocatorInfo, &_allocator) != VK_SUCCESS)
 		{
 			throw std::runtime_error("VMA : Unable to create allocator");
 		}
 		assert(_allocator);
+
+		VkPhysicalDeviceProperties properties = {};
+		vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+		const VkPhysicalDeviceLimits& limits = properties.limits;
+		// The pools only create their blocks on the first allocation
+		_bufferPools[static_cast<std::size_t>(BufferUsage::Uniform)] = std::make_unique<BufferPool>(*this,
+				VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU,
+				VMA_ALLOCATION_CREATE_MAPPED_BIT, UniformBlockSize,
+				std::max(limits.minUniformBufferOffsetAlignment, MinBufferAlignment));
+		_bufferPools[static_cast<std::size_t>(BufferUsage::Storage)] = std::make_unique<BufferPool>(*this,
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU,
+				VMA_ALLOCATION_CREATE_MAPPED_BIT, StorageBlockSize,
+				std::max(limits.minStorageBufferOffsetAlignment, MinBufferAlignment));
+		_bufferPools[static_cast<std::size_t>(BufferUsage::Geometry)] = std::make_unique<BufferPool>(*this,
+				VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				VMA_MEMORY_USAGE_GPU_ONLY, 0, GeometryBlockSize, MinBufferAlignment);
+		_bufferPools[static_cast<std::size_t>(BufferUsage::Staging)] = std::make_unique<BufferPool>(*this,
+				VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY, VMA_ALLOCATION_CREATE_MAPPED_BIT,
+				StagingBlockSize, std::max(limits.optimalBufferCopyOffsetAlignment, MinBufferAlignment));
 	}
 
 	Allocator::~Allocator()
 	{
+		// The pool blocks are VMA buffers, they have to go before the allocator
+		for (auto& pool : _bufferPools)
+			pool.reset();
 		vmaDestroyAllocator(_allocator);
 	}
+
+	PooledBuffer Allocator::allocateBuffer(BufferUsage usage, VkDeviceSize size)
+	{
+		return getBufferPool(usage).allocate(size);
+	}
+
+	BufferPool& Allocator::getBufferPool(BufferUsage usage)
+	{
+		assert(usage != BufferUsage::Count);
+		return *_bufferPools[static_cast<std::size_t>(usage)];
+	}
+
+	void Allocator::setCurrentFrameIndex(std::uint32_t frameIndex)
+	{
+		vmaSetCurrentFrameIndex(_allocator, frameIndex);
+	}
+
+	std::vector<MemoryHeapStatistics> Allocator::getHeapBudgets() const
+	{
+		const VkPhysicalDeviceMemoryProperties* memoryProperties = nullptr;
+		vmaGetMemoryProperties(_allocator, &memoryProperties);
+		VmaBudget budgets[VK_MAX_MEMORY_HEAPS] = {};
+		vmaGetHeapBudgets(_allocator, budgets);
+
+		std::vector<MemoryHeapStatistics> heaps(memoryProperties->memoryHeapCount);
+		for (std::uint32_t i = 0; i < memoryProperties->memoryHeapCount; ++i)
+		{
+			const VkMemoryHeap& heap = memoryProperties->memoryHeaps[i];
+			heaps[i].size = heap.size;
+			heaps[i].deviceLocal = (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+			heaps[i].usage = budgets[i].usage;
+			heaps[i].budget = budgets[i].budget;
+			heaps[i].blockBytes = budgets[i].statistics.blockBytes;
+			heaps[i].allocationBytes = budgets[i].statistics.allocationBytes;
+			heaps[i].blockCount = budgets[i].statistics.blockCount;
+			heaps[i].allocationCount = budgets[i].statistics.allocationCount;
+		}
+		return heaps;
+	}
+
+	MemoryStatistics Allocator::getStatistics() const
+	{
+		MemoryStatistics statistics = {};
+		statistics.heaps = getHeapBudgets();
+		for (std::size_t i = 0; i < _tagCounters.size(); ++i)
+		{
+			statistics.tags[i].allocationCount = _tagCounters[i].allocationCount.load(std::memory_order_relaxed);
+			statistics.tags[i].bytes = _tagCounters[i].bytes.load(std::memory_order_relaxed);
+		}
+		for (std::size_t i = 0; i < _bufferPools.size(); ++i)
+		{
+			statistics.pools[i].allocationCount = _bufferPools[i]->getAllocationCount();
+			statistics.pools[i].bytes = _bufferPools[i]->getUsedSize();
+		}
+
+		VmaTotalStatistics totalStatistics = {};
+		vmaCalculateStatistics(_allocator, &totalStatistics);
+		const VmaDetailedStatistics& total = totalStatistics.total;
+		statistics.unusedRangeCount = total.unusedRangeCount;
+		statistics.unusedBytes = total.statistics.blockBytes - total.statistics.allocationBytes;
+		statistics.largestUnusedRange = total.unusedRangeCount != 0 ? total.unusedRangeSizeMax : 0;
+		if (statistics.unusedBytes != 0)
+			statistics.fragmentation = 1.f - static_cast<float>(statistics.largestUnusedRange) /
+											 static_cast<float>(statistics.unusedBytes);
+		return statistics;
+	}
+
+	std::string Allocator::buildStatsString(bool detailedMap) const
+	{
+		char* statsString = nullptr;
+		vmaBuildStatsString(_allocator, &statsString, detailedMap ? VK_TRUE : VK_FALSE);
+		std::string result = statsString != nullptr ? statsString : "";
+		vmaFreeStatsString(_allocator, statsString);
+		return result;
+	}
+
+	bool Allocator::writeStatsFile(const std::string& fileName, bool detailedMap) const
+	{
+		std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+		if (!file)
+			return false;
+		file << buildStatsString(detailedMap);
+		return static_cast<bool>(file);
+	}
+
+	bool Allocator::hasMemoryBudget() const
+	{
+		return _memoryBudget;
+	}
+
+	void Allocator::trackAllocation(MemoryTag tag, VkDeviceSize size)
+	{
+		assert(tag != MemoryTag::Count);
+		TagCounters& counters = _tagCounters[static_cast<std::size_t>(tag)];
+		counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+		counters.bytes.fetch_add(size, std::memory_order_relaxed);
+	}
+
+	void Allocator::untrackAllocation(MemoryTag tag, VkDeviceSize size)
+	{
+		assert(tag != MemoryTag::Count);
+		TagCounters& counters = _tagCounters[static_cast<std::size_t>(tag)];
+		counters.allocationCount.fetch_sub(1, std::memory_order_relaxed);
+		counters.bytes.fetch_sub(size, std::memory_order_relaxed);
+	}
+
+	void Allocator::destroyBuffer(VkBuffer buffer, VmaAllocation allocation)
+	{
+		if (_defragmenter != nullptr && _defragmenter->abandon(allocation))
+			allocation = VK_NULL_HANDLE;
+		vmaDestroyBuffer(_allocator, buffer, allocation);
+	}
 }
\ No newline at end of file
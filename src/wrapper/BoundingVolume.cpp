@@ -0,0 +1,368 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/BoundingVolume.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CONCERTO_BOUNDS_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CONCERTO_BOUNDS_SSE2
+#endif
+
+namespace Concerto::Graphics::Wrapper
+{
+	namespace
+	{
+		// The SIMD pre-test only skips points well inside the sphere, the scalar test decides for the others
+		constexpr float GrowMargin = 0.9999f;
+
+		struct Extremes
+		{
+			std::size_t min[3];
+			std::size_t max[3];
+		};
+
+		void updateExtremes(Extremes& extremes, std::span<const glm::vec3> positions, std::size_t first)
+		{
+			for (std::size_t i = first; i < positions.size(); ++i)
+			{
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					if (positions[i][axis] < positions[extremes.min[axis]][axis])
+						extremes.min[axis] = i;
+					if (positions[i][axis] > positions[extremes.max[axis]][axis])
+						extremes.max[axis] = i;
+				}
+			}
+		}
+
+		BoundingSphere makeInitialSphere(std::span<const glm::vec3> positions, const Extremes& extremes)
+		{
+			// Start from the most distant pair along the axis with the largest spread
+			int widestAxis = 0;
+			float widestDistance = 0.f;
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				float distance = glm::distance(positions[extremes.min[axis]], positions[extremes.max[axis]]);
+				if (distance > widestDistance)
+				{
+					widestDistance = distance;
+					widestAxis = axis;
+				}
+			}
+			return { (positions[extremes.min[widestAxis]] + positions[extremes.max[widestAxis]]) * 0.5f,
+					 widestDistance * 0.5f };
+		}
+
+		void growSphere(BoundingSphere& sphere, std::span<const glm::vec3> positions, std::size_t first,
+				std::size_t last)
+		{
+			// Grow the sphere just enough to enclose every point outside of it
+			for (std::size_t i = first; i < last; ++i)
+			{
+				float distance = glm::distance(positions[i], sphere.center);
+				if (distance > sphere.radius)
+				{
+					float radius = (sphere.radius + distance) * 0.5f;
+					sphere.center += (positions[i] - sphere.center) * ((radius - sphere.radius) / distance);
+					sphere.radius = radius;
+				}
+			}
+		}
+
+#if defined(CONCERTO_BOUNDS_AVX2) || defined(CONCERTO_BOUNDS_SSE2)
+		namespace Simd
+		{
+#if defined(CONCERTO_BOUNDS_AVX2)
+			constexpr std::size_t Width = 8;
+			using Float = __m256;
+			using Int = __m256i;
+
+			inline Float set(float value) { return _mm256_set1_ps(value); }
+			inline Int set(std::int32_t value) { return _mm256_set1_epi32(value); }
+			inline Int laneIndices() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+			inline Int add(Int a, Int b) { return _mm256_add_epi32(a, b); }
+			inline Float add(Float a, Float b) { return _mm256_add_ps(a, b); }
+			inline Float sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+			inline Float mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+			inline Float less(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+			inline Float greater(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+			inline Float select(Float mask, Float a, Float b) { return _mm256_blendv_ps(b, a, mask); }
+			inline Int select(Float mask, Int a, Int b)
+			{
+				return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(b), _mm256_castsi256_ps(a), mask));
+			}
+			inline bool any(Float mask) { return _mm256_movemask_ps(mask) != 0; }
+			inline void store(float* out, Float value) { _mm256_storeu_ps(out, value); }
+			inline void store(std::int32_t* out, Int value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), value); }
+
+			inline void loadPositions(const glm::vec3* positions, Float& x, Float& y, Float& z)
+			{
+				const Int offsets = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+				const float* base = &positions->x;
+				x = _mm256_i32gather_ps(base, offsets, 4);
+				y = _mm256_i32gather_ps(base + 1, offsets, 4);
+				z = _mm256_i32gather_ps(base + 2, offsets, 4);
+			}
+#else
+			constexpr std::size_t Width = 4;
+			using Float = __m128;
+			using Int = __m128i;
+
+			inline Float set(float value) { return _mm_set1_ps(value); }
+			inline Int set(std::int32_t value) { return _mm_set1_epi32(value); }
+			inline Int laneIndices() { return _mm_setr_epi32(0, 1, 2, 3); }
+			inline Int add(Int a, Int b) { return _mm_add_epi32(a, b); }
+			inline Float add(Float a, Float b) { return _mm_add_ps(a, b); }
+			inline Float sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+			inline Float mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+			inline Float less(Float a, Float b) { return _mm_cmplt_ps(a, b); }
+			inline Float greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+			inline Float select(Float mask, Float a, Float b)
+			{
+				return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+			}
+			inline Int select(Float mask, Int a, Int b)
+			{
+				return _mm_castps_si128(select(mask, _mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+			}
+			inline bool any(Float mask) { return _mm_movemask_ps(mask) != 0; }
+			inline void store(float* out, Float value) { _mm_storeu_ps(out, value); }
+			inline void store(std::int32_t* out, Int value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out), value); }
+
+			inline void loadPositions(const glm::vec3* positions, Float& x, Float& y, Float& z)
+			{
+				// x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 to x0 x1 x2 x3 | y0 y1 y2 y3 | z0 z1 z2 z3
+				const float* base = &positions->x;
+				const Float r0 = _mm_loadu_ps(base);
+				const Float r1 = _mm_loadu_ps(base + 4);
+				const Float r2 = _mm_loadu_ps(base + 8);
+				x = _mm_shuffle_ps(_mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 3, 0, 0)),
+						_mm_shuffle_ps(r1, r2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+				y = _mm_shuffle_ps(_mm_shuffle_ps(r0, r1, _MM_SHUFFLE(0, 0, 1, 1)),
+						_mm_shuffle_ps(r1, r2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+				z = _mm_shuffle_ps(_mm_shuffle_ps(r0, r1, _MM_SHUFFLE(1, 1, 2, 2)),
+						_mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+			}
+#endif
+		}
+
+		Extremes findExtremes(std::span<const glm::vec3> positions)
+		{
+			using namespace Simd;
+			Float minValues[3] = { set(std::numeric_limits<float>::infinity()),
+								   set(std::numeric_limits<float>::infinity()),
+								   set(std::numeric_limits<float>::infinity()) };
+			Float maxValues[3] = { set(-std::numeric_limits<float>::infinity()),
+								   set(-std::numeric_limits<float>::infinity()),
+								   set(-std::numeric_limits<float>::infinity()) };
+			Int minIndices[3] = { set(0), set(0), set(0) };
+			Int maxIndices[3] = { set(0), set(0), set(0) };
+			Int indices = laneIndices();
+			const Int step = set(static_cast<std::int32_t>(Width));
+			std::size_t i = 0;
+			for (; i + Width <= positions.size(); i += Width)
+			{
+				Float values[3];
+				loadPositions(positions.data() + i, values[0], values[1], values[2]);
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					Float isMin = less(values[axis], minValues[axis]);
+					minValues[axis] = select(isMin, values[axis], minValues[axis]);
+					minIndices[axis] = select(isMin, indices, minIndices[axis]);
+					Float isMax = greater(values[axis], maxValues[axis]);
+					maxValues[axis] = select(isMax, values[axis], maxValues[axis]);
+					maxIndices[axis] = select(isMax, indices, maxIndices[axis]);
+				}
+				indices = add(indices, step);
+			}
+
+			// Every lane kept its first extreme, among lanes the lowest index wins ties like in the scalar loop
+			Extremes extremes{ { 0, 0, 0 }, { 0, 0, 0 } };
+			if (i != 0)
+			{
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					float laneValues[Width];
+					std::int32_t laneIndices[Width];
+					store(laneValues, minValues[axis]);
+					store(laneIndices, minIndices[axis]);
+					std::size_t best = 0;
+					for (std::size_t lane = 1; lane < Width; ++lane)
+						if (laneValues[lane] < laneValues[best] ||
+							(laneValues[lane] == laneValues[best] && laneIndices[lane] < laneIndices[best]))
+							best = lane;
+					extremes.min[axis] = static_cast<std::size_t>(laneIndices[best]);
+
+					store(laneValues, maxValues[axis]);
+					store(laneIndices, maxIndices[axis]);
+					best = 0;
+					for (std::size_t lane = 1; lane < Width; ++lane)
+						if (laneValues[lane] > laneValues[best] ||
+							(laneValues[lane] == laneValues[best] && laneIndices[lane] < laneIndices[best]))
+							best = lane;
+					extremes.max[axis] = static_cast<std::size_t>(laneIndices[best]);
+				}
+			}
+			updateExtremes(extremes, positions, i);
+			return extremes;
+		}
+
+		void growSphere(BoundingSphere& sphere, std::span<const glm::vec3> positions)
+		{
+			using namespace Simd;
+			std::size_t i = 0;
+			for (; i + Width <= positions.size(); i += Width)
+			{
+				Float x, y, z;
+				loadPositions(positions.data() + i, x, y, z);
+				x = sub(x, set(sphere.center.x));
+				y = sub(y, set(sphere.center.y));
+				z = sub(z, set(sphere.center.z));
+				Float squaredDistance = add(add(mul(x, x), mul(y, y)), mul(z, z));
+				if (any(greater(squaredDistance, set(sphere.radius * sphere.radius * GrowMargin))))
+					growSphere(sphere, positions, i, i + Width);
+			}
+			growSphere(sphere, positions, i, positions.size());
+		}
+
+		BoundingBox computeBoundingBoxSimd(std::span<const Vertex> vertices)
+		{
+			static_assert(offsetof(Vertex, normal) == offsetof(Vertex, position) + sizeof(glm::vec3),
+					"the four float loads of a position must stay inside its vertex");
+			// One vertex per 128 bits lane, the w lane holds normal.x and is ignored
+			__m128 boxMin = _mm_loadu_ps(&vertices.front().position.x);
+			__m128 boxMax = boxMin;
+			std::size_t i = 1;
+#if defined(CONCERTO_BOUNDS_AVX2)
+			__m256 boxMin2 = _mm256_set_m128(boxMin, boxMin);
+			__m256 boxMax2 = boxMin2;
+			for (; i + 2 <= vertices.size(); i += 2)
+			{
+				__m256 positions = _mm256_set_m128(_mm_loadu_ps(&vertices[i + 1].position.x),
+						_mm_loadu_ps(&vertices[i].position.x));
+				boxMin2 = _mm256_min_ps(boxMin2, positions);
+				boxMax2 = _mm256_max_ps(boxMax2, positions);
+			}
+			boxMin = _mm_min_ps(_mm256_castps256_ps128(boxMin2), _mm256_extractf128_ps(boxMin2, 1));
+			boxMax = _mm_max_ps(_mm256_castps256_ps128(boxMax2), _mm256_extractf128_ps(boxMax2, 1));
+#endif
+			for (; i < vertices.size(); ++i)
+			{
+				__m128 position = _mm_loadu_ps(&vertices[i].position.x);
+				boxMin = _mm_min_ps(boxMin, position);
+				boxMax = _mm_max_ps(boxMax, position);
+			}
+			float min[4];
+			float max[4];
+			_mm_storeu_ps(min, boxMin);
+			_mm_storeu_ps(max, boxMax);
+			return { glm::vec3(min[0], min[1], min[2]), glm::vec3(max[0], max[1], max[2]) };
+		}
+#endif
+	}
+
+	BoundingBox computeBoundingBoxScalar(std::span<const Vertex> vertices)
+	{
+		if (vertices.empty())
+			return { glm::vec3(0.f), glm::vec3(0.f) };
+		BoundingBox box{ vertices.front().position, vertices.front().position };
+		for (const Vertex& vertex: vertices)
+		{
+			box.min = glm::min(box.min, vertex.position);
+			box.max = glm::max(box.max, vertex.position);
+		}
+		return box;
+	}
+
+	BoundingSphere computeBoundingSphereScalar(std::span<const glm::vec3> positions)
+	{
+		if (positions.empty())
+			return { glm::vec3(0.f), 0.f };
+		Extremes extremes{ { 0, 0, 0 }, { 0, 0, 0 } };
+		updateExtremes(extremes, positions, 0);
+		BoundingSphere sphere = makeInitialSphere(positions, extremes);
+		growSphere(sphere, positions, 0, positions.size());
+		return sphere;
+	}
+
+	BoundingBox computeBoundingBox(std::span<const Vertex> vertices)
+	{
+#if defined(CONCERTO_BOUNDS_AVX2) || defined(CONCERTO_BOUNDS_SSE2)
+		if (vertices.empty())
+			return { glm::vec3(0.f), glm::vec3(0.f) };
+		return computeBoundingBoxSimd(vertices);
+#else
+		return computeBoundingBoxScalar(vertices);
+#endif
+	}
+
+	BoundingSphere computeBoundingSphere(std::span<const glm::vec3> positions)
+	{
+#if defined(CONCERTO_BOUNDS_AVX2) || defined(CONCERTO_BOUNDS_SSE2)
+		if (positions.empty())
+			return { glm::vec3(0.f), 0.f };
+		BoundingSphere sphere = makeInitialSphere(positions, findExtremes(positions));
+		growSphere(sphere, positions);
+		return sphere;
+#else
+		return computeBoundingSphereScalar(positions);
+#endif
+	}
+
+	BoundingSphere computeBoundingSphere(std::span<const Vertex> vertices)
+	{
+		std::vector<glm::vec3> positions;
+		positions.reserve(vertices.size());
+		for (const Vertex& vertex: vertices)
+			positions.push_back(vertex.position);
+		return computeBoundingSphere(positions);
+	}
+
+	const char* getBoundingVolumeKernelName()
+	{
+#if defined(CONCERTO_BOUNDS_AVX2)
+		return "AVX2";
+#elif defined(CONCERTO_BOUNDS_SSE2)
+		return "SSE2";
+#else
+		return "Scalar";
+#endif
+	}
+
+	Frustum extractFrustum(const glm::mat4& viewProjection)
+	{
+		auto row = [&](int i)
+		{
+			return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+		};
+		Frustum frustum{};
+		frustum.planes[0] = row(3) + row(0); // left
+		frustum.planes[1] = row(3) - row(0); // right
+		frustum.planes[2] = row(3) + row(1); // bottom
+		frustum.planes[3] = row(3) - row(1); // top
+		frustum.planes[4] = row(2); // near
+		frustum.planes[5] = row(3) - row(2); // far
+		for (glm::vec4& plane: frustum.planes)
+			plane /= glm::length(glm::vec3(plane));
+		return frustum;
+	}
+
+	bool intersects(const Frustum& frustum, const BoundingSphere& sphere)
+	{
+		for (const glm::vec4& plane: frustum.planes)
+		{
+			if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius)
+				return false;
+		}
+		return true;
+	}
+}
\ No newline at end of file
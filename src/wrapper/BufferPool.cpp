@@ -0,0 +1,212 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/BufferPool.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include "wrapper/AllocatedBuffer.hpp"
+#include "wrapper/OffsetAllocator.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	struct BufferPool::Block
+	{
+		Block(Allocator& allocator, VkDeviceSize size, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage,
+				VmaAllocationCreateFlags allocationFlags) : buffer(allocator, size, usage, memoryUsage, allocationFlags),
+															ranges(size),
+															allocationCount(0)
+		{
+		}
+
+		AllocatedBuffer buffer;
+		OffsetAllocator ranges;
+		std::size_t allocationCount;
+	};
+
+	PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept : _pool(std::exchange(other._pool, nullptr)),
+																_block(std::exchange(other._block, nullptr)),
+																_offset(std::exchange(other._offset, 0)),
+																_size(std::exchange(other._size, 0)),
+																_data(std::exchange(other._data, nullptr))
+	{
+	}
+
+	PooledBuffer& PooledBuffer::operator=(PooledBuffer&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+		reset();
+		_pool = std::exchange(other._pool, nullptr);
+		_block = std::exchange(other._block, nullptr);
+		_offset = std::exchange(other._offset, 0);
+		_size = std::exchange(other._size, 0);
+		_data = std::exchange(other._data, nullptr);
+		return *this;
+	}
+
+	PooledBuffer::~PooledBuffer()
+	{
+		reset();
+	}
+
+	bool PooledBuffer::isValid() const
+	{
+		return _pool != nullptr;
+	}
+
+	VkBuffer PooledBuffer::getBuffer() const
+	{
+		assert(isValid());
+		return static_cast<const BufferPool::Block*>(_block)->buffer._buffer;
+	}
+
+	VkDeviceSize PooledBuffer::getOffset() const
+	{
+		return _offset;
+	}
+
+	VkDeviceSize PooledBuffer::getSize() const
+	{
+		return _size;
+	}
+
+	bool PooledBuffer::isMapped() const
+	{
+		return _data != nullptr;
+	}
+
+	void PooledBuffer::flush() const
+	{
+		assert(isValid());
+		_pool->flush(*this);
+	}
+
+	void PooledBuffer::reset()
+	{
+		if (_pool == nullptr)
+			return;
+		_pool->free(*this);
+		_pool = nullptr;
+		_block = nullptr;
+		_offset = 0;
+		_size = 0;
+		_data = nullptr;
+	}
+
+	BufferPool::BufferPool(Allocator& allocator, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage,
+			VmaAllocationCreateFlags allocationFlags, VkDeviceSize blockSize, VkDeviceSize alignment) :
+			_allocator(allocator),
+			_usage(usage),
+			_memoryUsage(memoryUsage),
+			_allocationFlags(allocationFlags),
+			_blockSize(blockSize),
+			_alignment(std::max<VkDeviceSize>(alignment, 1)),
+			_allocationCount(0),
+			_usedSize(0)
+	{
+	}
+
+	BufferPool::~BufferPool()
+	{
+		assert(_allocationCount == 0 && "BufferPool destroyed with live PooledBuffers");
+	}
+
+	PooledBuffer BufferPool::allocate(VkDeviceSize size)
+	{
+		if (size == 0)
+			throw std::invalid_argument("BufferPool: empty allocation");
+		std::lock_guard lock(_mutex);
+		Block* block = nullptr;
+		std::optional<std::uint64_t> offset;
+		// The newest blocks are the least fragmented ones
+		for (auto it = _blocks.rbegin(); it != _blocks.rend() && !offset; ++it)
+		{
+			if ((*it)->ranges.getLargestFreeRange() < size)
+				continue;
+			offset = (*it)->ranges.allocate(size, _alignment);
+			block = it->get();
+		}
+		if (!offset)
+		{
+			_blocks.push_back(std::make_unique<Block>(_allocator, std::max(size, _blockSize), _usage, _memoryUsage,
+					_allocationFlags));
+			block = _blocks.back().get();
+			offset = block->ranges.allocate(size, _alignment);
+			assert(offset);
+		}
+		++block->allocationCount;
+		++_allocationCount;
+		_usedSize += size;
+
+		PooledBuffer buffer;
+		buffer._pool = this;
+		buffer._block = block;
+		buffer._offset = *offset;
+		buffer._size = size;
+		if (block->buffer.isMapped())
+			buffer._data = block->buffer.getMappedData().data() + *offset;
+		return buffer;
+	}
+
+	VkBufferUsageFlags BufferPool::getUsage() const
+	{
+		return _usage;
+	}
+
+	VkDeviceSize BufferPool::getAlignment() const
+	{
+		return _alignment;
+	}
+
+	std::size_t BufferPool::getBlockCount() const
+	{
+		std::lock_guard lock(_mutex);
+		return _blocks.size();
+	}
+
+	std::size_t BufferPool::getAllocationCount() const
+	{
+		std::lock_guard lock(_mutex);
+		return _allocationCount;
+	}
+
+	VkDeviceSize BufferPool::getUsedSize() const
+	{
+		std::lock_guard lock(_mutex);
+		return _usedSize;
+	}
+
+	VkDeviceSize BufferPool::getReservedSize() const
+	{
+		std::lock_guard lock(_mutex);
+		VkDeviceSize size = 0;
+		for (const auto& block : _blocks)
+			size += block->ranges.getSize();
+		return size;
+	}
+
+	void BufferPool::free(const PooledBuffer& buffer)
+	{
+		std::lock_guard lock(_mutex);
+		auto* block = static_cast<Block*>(buffer._block);
+		block->ranges.free(buffer._offset, buffer._size);
+		--block->allocationCount;
+		--_allocationCount;
+		_usedSize -= buffer._size;
+		// A dedicated block is not worth keeping around for the next small allocations
+		if (block->allocationCount != 0 || (_blocks.size() == 1 && block->ranges.getSize() == _blockSize))
+			return;
+		auto it = std::find_if(_blocks.begin(), _blocks.end(), [block](const auto& b) { return b.get() == block; });
+		assert(it != _blocks.end());
+		_blocks.erase(it);
+	}
+
+	void BufferPool::flush(const PooledBuffer& buffer) const
+	{
+		static_cast<const Block*>(buffer._block)->buffer.flush(buffer._offset, buffer._size);
+	}
+} // Concerto::Graphics::Wrapper
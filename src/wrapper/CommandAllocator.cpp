@@ -0,0 +1,41 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/CommandAllocator.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	CommandAllocator::CommandAllocator(VkDevice device, std::uint32_t queueFamily) : _device(device),
+																					 _commandPool(device, queueFamily,
+																							 VK_COMMAND_POOL_CREATE_TRANSIENT_BIT)
+	{
+	}
+
+	CommandBuffer& CommandAllocator::allocate(VkCommandBufferLevel level)
+	{
+		FreeList& freeList = level == VK_COMMAND_BUFFER_LEVEL_PRIMARY ? _primary : _secondary;
+		if (freeList.usedCount == freeList.commandBuffers.size())
+			freeList.commandBuffers.push_back(std::make_unique<CommandBuffer>(_device, _commandPool.get(), level));
+		return *freeList.commandBuffers[freeList.usedCount++];
+	}
+
+	void CommandAllocator::reset()
+	{
+		if (_primary.usedCount == 0 && _secondary.usedCount == 0)
+			return;
+		_commandPool.reset();
+		_primary.usedCount = 0;
+		_secondary.usedCount = 0;
+	}
+
+	std::size_t CommandAllocator::getUsedCount() const
+	{
+		return _primary.usedCount + _secondary.usedCount;
+	}
+
+	std::size_t CommandAllocator::getCapacity() const
+	{
+		return _primary.commandBuffers.size() + _secondary.commandBuffers.size();
+	}
+} // Concerto::Graphics::Wrapper
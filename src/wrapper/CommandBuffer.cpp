@@ -4,20 +4,56 @@
 
 
 #include "wrapper/CommandBuffer.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <stdexcept>
 #include <iostream>
 
 namespace Concerto::Graphics::Wrapper
 {
-	CommandBuffer::CommandBuffer(VkDevice device, VkCommandPool commandPool) : _device(device),
-																			   _commandPool(commandPool)
+	const char* getStateCommandName(StateCommand command)
+	{
+		switch (command)
+		{
+		case StateCommand::Pipeline:
+			return "Pipeline";
+		case StateCommand::DescriptorSets:
+			return "DescriptorSets";
+		case StateCommand::VertexBuffers:
+			return "VertexBuffers";
+		case StateCommand::IndexBuffer:
+			return "IndexBuffer";
+		case StateCommand::PushConstants:
+			return "PushConstants";
+		default:
+			return "Unknown";
+		}
+	}
+
+	void addStateStatistics(StateStatistics& total, const StateStatistics& statistics)
+	{
+		for (std::size_t i = 0; i < total.size(); ++i)
+		{
+			total[i].issued += statistics[i].issued;
+			total[i].elided += statistics[i].elided;
+		}
+	}
+
+	CommandBuffer::CommandBuffer(VkDevice device, VkCommandPool commandPool, VkCommandBufferLevel level) :
+			_device(device),
+			_commandPool(commandPool),
+			_level(level),
+			_drawIndexedIndirectCount(nullptr),
+			_state(),
+			_stateStatistics()
 	{
 		VkCommandBufferAllocateInfo info = {};
 		info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 		info.pNext = nullptr;
 		info.commandPool = _commandPool;
 		info.commandBufferCount = 1;
-		info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		info.level = _level;
 
 		if (vkAllocateCommandBuffers(_device, &info, &_commandBuffer) != VK_SUCCESS)
 		{
@@ -30,6 +66,21 @@ namespace Concerto::Graphics::Wrapper
 		return _commandBuffer;
 	}
 
+	VkCommandBufferLevel CommandBuffer::getLevel() const
+	{
+		return _level;
+	}
+
+	const StateStatistics& CommandBuffer::getStateStatistics() const
+	{
+		return _stateStatistics;
+	}
+
+	void CommandBuffer::invalidateState()
+	{
+		_state = {};
+	}
+
 	CommandBuffer::~CommandBuffer()
 	{
 		vkFreeCommandBuffers(_device, _commandPool, 1, &_commandBuffer);
@@ -42,6 +93,7 @@ namespace Concerto::Graphics::Wrapper
 		{
 			throw std::runtime_error("vkResetCommandBuffer fail");
 		}
+		invalidateState();
 	}
 
 	void CommandBuffer::begin()
@@ -57,6 +109,27 @@ namespace Concerto::Graphics::Wrapper
 		{
 			throw std::runtime_error("vkBeginCommandBuffer fail");
 		}
+		invalidateState();
+		_stateStatistics = {};
+	}
+
+	void CommandBuffer::begin(const VkCommandBufferInheritanceInfo& inheritanceInfo)
+	{
+		assert(_level == VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+		VkCommandBufferBeginInfo cmdBeginInfo = {};
+
+		cmdBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		cmdBeginInfo.pNext = nullptr;
+		cmdBeginInfo.pInheritanceInfo = &inheritanceInfo;
+		cmdBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+							 VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+
+		if (vkBeginCommandBuffer(_commandBuffer, &cmdBeginInfo) != VK_SUCCESS)
+		{
+			throw std::runtime_error("vkBeginCommandBuffer fail");
+		}
+		invalidateState();
+		_stateStatistics = {};
 	}
 
 	void CommandBuffer::end()
@@ -67,9 +140,9 @@ namespace Concerto::Graphics::Wrapper
 		}
 	}
 
-	void CommandBuffer::beginRenderPass(VkRenderPassBeginInfo info)
+	void CommandBuffer::beginRenderPass(VkRenderPassBeginInfo info, VkSubpassContents contents)
 	{
-		vkCmdBeginRenderPass(_commandBuffer, &info, VK_SUBPASS_CONTENTS_INLINE);
+		vkCmdBeginRenderPass(_commandBuffer, &info, contents);
 	}
 
 	void CommandBuffer::endRenderPass()
@@ -79,12 +152,21 @@ namespace Concerto::Graphics::Wrapper
 
 	void CommandBuffer::bindPipeline(VkPipelineBindPoint pipelineBindPoint, Pipeline& pipeline)
 	{
-		vkCmdBindPipeline(_commandBuffer, pipelineBindPoint, pipeline.get());
+		bindPipeline(pipelineBindPoint, pipeline.get());
 	}
 
 	void CommandBuffer::bindPipeline(VkPipelineBindPoint pipelineBindPoint, VkPipeline pipeline)
 	{
+		const bool tracked = static_cast<std::size_t>(pipelineBindPoint) < BindPointCount;
+		if (tracked && _state.pipelines[pipelineBindPoint] == pipeline)
+		{
+			count(StateCommand::Pipeline, true);
+			return;
+		}
 		vkCmdBindPipeline(_commandBuffer, pipelineBindPoint, pipeline);
+		count(StateCommand::Pipeline, false);
+		if (tracked)
+			_state.pipelines[pipelineBindPoint] = pipeline;
 	}
 
 	void CommandBuffer::draw(std::uint32_t vertexCount, std::uint32_t instanceCount, std::uint32_t firstVertex,
@@ -93,37 +175,224 @@ namespace Concerto::Graphics::Wrapper
 		vkCmdDraw(_commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
 	}
 
+	void CommandBuffer::drawIndexed(std::uint32_t indexCount, std::uint32_t instanceCount, std::uint32_t firstIndex,
+			std::int32_t vertexOffset, std::uint32_t firstInstance)
+	{
+		vkCmdDrawIndexed(_commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+	}
+
+	void CommandBuffer::drawIndexedIndirect(VkBuffer buffer, VkDeviceSize offset, std::uint32_t drawCount,
+			std::uint32_t stride)
+	{
+		vkCmdDrawIndexedIndirect(_commandBuffer, buffer, offset, drawCount, stride);
+	}
+
+	void CommandBuffer::drawIndexedIndirectCount(VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer,
+			VkDeviceSize countOffset, std::uint32_t maxDrawCount, std::uint32_t stride)
+	{
+		// Not a core command before Vulkan 1.2, so the loader does not export it
+		if (_drawIndexedIndirectCount == nullptr)
+		{
+			_drawIndexedIndirectCount = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+					vkGetDeviceProcAddr(_device, "vkCmdDrawIndexedIndirectCountKHR"));
+			if (_drawIndexedIndirectCount == nullptr)
+				throw std::runtime_error("vkCmdDrawIndexedIndirectCountKHR is not available");
+		}
+		_drawIndexedIndirectCount(_commandBuffer, buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+	}
+
+	void CommandBuffer::dispatch(std::uint32_t groupCountX, std::uint32_t groupCountY, std::uint32_t groupCountZ)
+	{
+		vkCmdDispatch(_commandBuffer, groupCountX, groupCountY, groupCountZ);
+	}
+
+	void CommandBuffer::fillBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size, std::uint32_t data)
+	{
+		vkCmdFillBuffer(_commandBuffer, buffer, offset, size, data);
+	}
+
+	void CommandBuffer::executeCommands(std::span<const VkCommandBuffer> commandBuffers)
+	{
+		if (commandBuffers.empty())
+			return;
+		vkCmdExecuteCommands(_commandBuffer, static_cast<std::uint32_t>(commandBuffers.size()),
+				commandBuffers.data());
+		// The state is undefined after secondary command buffers
+		invalidateState();
+	}
+
+	void CommandBuffer::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, std::span<const VkBufferCopy> regions)
+	{
+		vkCmdCopyBuffer(_commandBuffer, srcBuffer, dstBuffer, static_cast<std::uint32_t>(regions.size()),
+				regions.data());
+	}
+
+	void CommandBuffer::memoryBarrier(VkPipelineStageFlags srcStageMask, VkAccessFlags srcAccessMask,
+			VkPipelineStageFlags dstStageMask, VkAccessFlags dstAccessMask)
+	{
+		VkMemoryBarrier barrier = {};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.pNext = nullptr;
+		barrier.srcAccessMask = srcAccessMask;
+		barrier.dstAccessMask = dstAccessMask;
+		vkCmdPipelineBarrier(_commandBuffer, srcStageMask, dstStageMask, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+	}
+
 	void CommandBuffer::bindVertexBuffers(const AllocatedBuffer& buffer)
 	{
-		VkDeviceSize offset = 0;
-		vkCmdBindVertexBuffers(_commandBuffer, 0, 1, &buffer._buffer, &offset);
+		const VkDeviceSize offset = 0;
+		bindVertexBuffers(0, { &buffer._buffer, 1 }, { &offset, 1 });
+	}
+
+	void CommandBuffer::bindVertexBuffers(std::uint32_t firstBinding, std::span<const VkBuffer> buffers,
+			std::span<const VkDeviceSize> offsets)
+	{
+		assert(buffers.size() == offsets.size());
+		const bool tracked = firstBinding + buffers.size() <= MaxTrackedVertexBindings;
+		if (tracked && std::equal(buffers.begin(), buffers.end(), _state.vertexBuffers.begin() + firstBinding) &&
+			std::equal(offsets.begin(), offsets.end(), _state.vertexBufferOffsets.begin() + firstBinding))
+		{
+			count(StateCommand::VertexBuffers, true);
+			return;
+		}
+		vkCmdBindVertexBuffers(_commandBuffer, firstBinding, static_cast<std::uint32_t>(buffers.size()), buffers.data(),
+				offsets.data());
+		count(StateCommand::VertexBuffers, false);
+		if (tracked)
+		{
+			std::copy(buffers.begin(), buffers.end(), _state.vertexBuffers.begin() + firstBinding);
+			std::copy(offsets.begin(), offsets.end(), _state.vertexBufferOffsets.begin() + firstBinding);
+		}
+	}
+
+	void CommandBuffer::bindIndexBuffer(const AllocatedBuffer& buffer, VkIndexType indexType)
+	{
+		bindIndexBuffer(buffer._buffer, 0, indexType);
+	}
+
+	void CommandBuffer::bindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType)
+	{
+		if (_state.indexBuffer == buffer && _state.indexBufferOffset == offset && _state.indexType == indexType)
+		{
+			count(StateCommand::IndexBuffer, true);
+			return;
+		}
+		vkCmdBindIndexBuffer(_commandBuffer, buffer, offset, indexType);
+		count(StateCommand::IndexBuffer, false);
+		_state.indexBuffer = buffer;
+		_state.indexBufferOffset = offset;
+		_state.indexType = indexType;
 	}
 
 	void CommandBuffer::updatePushConstants(PipelineLayout& pipelineLayout, MeshPushConstants& meshPushConstants)
 	{
-		vkCmdPushConstants(_commandBuffer, pipelineLayout.get(), VK_SHADER_STAGE_VERTEX_BIT, 0,
-				sizeof(MeshPushConstants), &meshPushConstants);
+		pushConstants(pipelineLayout.get(), VK_SHADER_STAGE_VERTEX_BIT, &meshPushConstants,
+				sizeof(MeshPushConstants));
 	}
 
 	void CommandBuffer::updatePushConstants(VkPipelineLayout pipelineLayout, MeshPushConstants& meshPushConstants)
 	{
-		vkCmdPushConstants(_commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(MeshPushConstants),
-				&meshPushConstants);
+		pushConstants(pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, &meshPushConstants, sizeof(MeshPushConstants));
+	}
+
+	void CommandBuffer::pushConstants(VkPipelineLayout pipelineLayout, VkShaderStageFlags stageFlags, const void* data,
+			std::uint32_t size, std::uint32_t offset)
+	{
+		const bool tracked = offset + size <= MaxTrackedPushConstantSize;
+		if (tracked && _state.pushConstantLayout == pipelineLayout &&
+			std::all_of(_state.pushConstantStages.begin() + offset, _state.pushConstantStages.begin() + offset + size,
+					[&](VkShaderStageFlags stages)
+					{
+						return stages == stageFlags;
+					}) && std::memcmp(_state.pushConstants.data() + offset, data, size) == 0)
+		{
+			count(StateCommand::PushConstants, true);
+			return;
+		}
+		vkCmdPushConstants(_commandBuffer, pipelineLayout, stageFlags, offset, size, data);
+		count(StateCommand::PushConstants, false);
+		// Values pushed with another layout are not known to be compatible with this one
+		if (_state.pushConstantLayout != pipelineLayout || !tracked)
+		{
+			_state.pushConstantStages.fill(0);
+			_state.pushConstantLayout = tracked ? pipelineLayout : VK_NULL_HANDLE;
+		}
+		if (!tracked)
+			return;
+		std::memcpy(_state.pushConstants.data() + offset, data, size);
+		std::fill(_state.pushConstantStages.begin() + offset, _state.pushConstantStages.begin() + offset + size,
+				stageFlags);
 	}
 
 	void CommandBuffer::bindDescriptorSets(VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout pipelineLayout,
 			std::uint32_t firstSet, std::uint32_t descriptorSetCount, DescriptorSet& descriptorSet, std::uint32_t dynamicOffsets)
 	{
-		auto vkDescriptorSet = descriptorSet.get();
-		vkCmdBindDescriptorSets(_commandBuffer, pipelineBindPoint, pipelineLayout, firstSet, descriptorSetCount,
-				&vkDescriptorSet, 1, &dynamicOffsets);
+		assert(descriptorSetCount == 1);
+		bindDescriptorSet(pipelineBindPoint, pipelineLayout, firstSet, descriptorSet.get(), { &dynamicOffsets, 1 });
 	}
 
 	void CommandBuffer::bindDescriptorSets(VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout pipelineLayout,
 			std::uint32_t firstSet, std::uint32_t descriptorSetCount, DescriptorSet& descriptorSet)
 	{
-		auto vkDescriptorSet = descriptorSet.get();
-		vkCmdBindDescriptorSets(_commandBuffer, pipelineBindPoint, pipelineLayout, firstSet, descriptorSetCount,
-				&vkDescriptorSet, 0, nullptr);
+		assert(descriptorSetCount == 1);
+		bindDescriptorSet(pipelineBindPoint, pipelineLayout, firstSet, descriptorSet.get(), {});
+	}
+
+	void CommandBuffer::bindDescriptorSets(VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout pipelineLayout,
+			std::uint32_t firstSet, std::uint32_t descriptorSetCount, DescriptorSet& descriptorSet,
+			std::span<const std::uint32_t> dynamicOffsets)
+	{
+		assert(descriptorSetCount == 1);
+		bindDescriptorSet(pipelineBindPoint, pipelineLayout, firstSet, descriptorSet.get(), dynamicOffsets);
+	}
+
+	void CommandBuffer::bindDescriptorSet(VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout pipelineLayout,
+			std::uint32_t set, VkDescriptorSet descriptorSet, std::span<const std::uint32_t> dynamicOffsets)
+	{
+		const bool trackedBindPoint = static_cast<std::size_t>(pipelineBindPoint) < BindPointCount;
+		const bool tracked = trackedBindPoint && set < MaxTrackedDescriptorSets &&
+							 dynamicOffsets.size() <= MaxTrackedDynamicOffsets;
+		if (tracked)
+		{
+			const BoundDescriptorSet& bound = _state.descriptorSets[pipelineBindPoint][set];
+			if (bound.pipelineLayout == pipelineLayout && bound.descriptorSet == descriptorSet &&
+				bound.dynamicOffsetCount == dynamicOffsets.size() &&
+				std::equal(dynamicOffsets.begin(), dynamicOffsets.end(), bound.dynamicOffsets.begin()))
+			{
+				count(StateCommand::DescriptorSets, true);
+				return;
+			}
+		}
+		vkCmdBindDescriptorSets(_commandBuffer, pipelineBindPoint, pipelineLayout, set, 1, &descriptorSet,
+				static_cast<std::uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+		count(StateCommand::DescriptorSets, false);
+		if (!trackedBindPoint)
+			return;
+		// The sets bound with another layout may have been disturbed
+		auto& boundSets = _state.descriptorSets[pipelineBindPoint];
+		for (BoundDescriptorSet& bound : boundSets)
+		{
+			if (bound.pipelineLayout != pipelineLayout)
+				bound = {};
+		}
+		if (set >= MaxTrackedDescriptorSets)
+			return;
+		BoundDescriptorSet& bound = boundSets[set];
+		bound = {};
+		if (!tracked)
+			return;
+		bound.pipelineLayout = pipelineLayout;
+		bound.descriptorSet = descriptorSet;
+		bound.dynamicOffsetCount = static_cast<std::uint32_t>(dynamicOffsets.size());
+		std::copy(dynamicOffsets.begin(), dynamicOffsets.end(), bound.dynamicOffsets.begin());
+	}
+
+	void CommandBuffer::count(StateCommand command, bool elided)
+	{
+		StateCommandCounters& counters = _stateStatistics[static_cast<std::size_t>(command)];
+		if (elided)
+			counters.elided++;
+		else
+			counters.issued++;
 	}
 }
\ No newline at end of file
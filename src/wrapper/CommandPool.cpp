@@ -4,20 +4,23 @@
 
 
 #include "wrapper/CommandPool.hpp"
+#include "wrapper/HostAllocator.hpp"
 #include <stdexcept>
 #include <iostream>
 
 namespace Concerto::Graphics::Wrapper
 {
-	CommandPool::CommandPool(VkDevice device, std::uint32_t queueFamily) : _device(device), _queueFamily(queueFamily)
+	CommandPool::CommandPool(VkDevice device, std::uint32_t queueFamily, VkCommandPoolCreateFlags flags) :
+			_device(device),
+			_queueFamily(queueFamily)
 	{
 		VkCommandPoolCreateInfo info {};
 		info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
 		info.pNext = nullptr;
-		info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+		info.flags = flags;
 		info.queueFamilyIndex = queueFamily;
 
-		VkResult result = vkCreateCommandPool(_device, &info, nullptr, &_commandPool);
+		VkResult result = vkCreateCommandPool(_device, &info, HostAllocator::getCallbacks(), &_commandPool);
 		if (result != VK_SUCCESS)
 		{
 			throw std::runtime_error("Failed to create command pool");
@@ -26,7 +29,7 @@ namespace Concerto::Graphics::Wrapper
 
 	CommandPool::~CommandPool()
 	{
-		vkDestroyCommandPool(_device, _commandPool, nullptr);
+		vkDestroyCommandPool(_device, _commandPool, HostAllocator::getCallbacks());
 		_commandPool = VK_NULL_HANDLE;
 	}
 
@@ -35,4 +38,12 @@ namespace Concerto::Graphics::Wrapper
 		return _commandPool;
 	}
 
+	void CommandPool::reset()
+	{
+		if (vkResetCommandPool(_device, _commandPool, 0) != VK_SUCCESS)
+		{
+			throw std::runtime_error("vkResetCommandPool fail");
+		}
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/ComputePipeline.hpp"
+
+#include <stdexcept>
+#include "wrapper/HostAllocator.hpp"
+#include "wrapper/VulkanInitializer.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	ComputePipeline::ComputePipeline(VkDevice device, VkPipelineLayout pipelineLayout, VkShaderModule shaderModule) :
+			_device(device),
+			_pipelineLayout(pipelineLayout),
+			_pipeline(VK_NULL_HANDLE)
+	{
+		VkComputePipelineCreateInfo pipelineInfo = {};
+		pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		pipelineInfo.pNext = nullptr;
+		pipelineInfo.flags = 0;
+		pipelineInfo.stage = VulkanInitializer::PipelineShaderStageCreateInfo(VK_SHADER_STAGE_COMPUTE_BIT,
+				shaderModule);
+		pipelineInfo.layout = _pipelineLayout;
+		pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+		pipelineInfo.basePipelineIndex = -1;
+
+		if (vkCreateComputePipelines(_device, VK_NULL_HANDLE, 1, &pipelineInfo, HostAllocator::getCallbacks(),
+				&_pipeline) != VK_SUCCESS)
+		{
+			throw std::runtime_error("Failed to create compute pipeline");
+		}
+	}
+
+	ComputePipeline::~ComputePipeline()
+	{
+		vkDestroyPipeline(_device, _pipeline, HostAllocator::getCallbacks());
+		_pipeline = VK_NULL_HANDLE;
+	}
+
+	VkPipeline ComputePipeline::get() const
+	{
+		return _pipeline;
+	}
+
+	VkPipelineLayout ComputePipeline::getPipelineLayout() const
+	{
+		return _pipelineLayout;
+	}
+} // Concerto::Graphics::Wrapper
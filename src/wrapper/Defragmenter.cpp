@@ -0,0 +1,182 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/Defragmenter.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+#include "wrapper/AllocatedBuffer.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	Defragmenter::Defragmenter(Allocator& allocator, DeletionQueue& deletionQueue, VkDeviceSize maxBytesPerPass,
+			std::uint32_t maxAllocationsPerPass) : _allocator(allocator),
+												   _deletionQueue(deletionQueue),
+												   _maxBytesPerPass(maxBytesPerPass),
+												   _maxAllocationsPerPass(maxAllocationsPerPass),
+												   _context(VK_NULL_HANDLE),
+												   _pass(),
+												   _passPending(false),
+												   _statistics()
+	{
+		assert(_allocator._defragmenter == nullptr && "Only one Defragmenter per Allocator");
+		_allocator._defragmenter = this;
+	}
+
+	Defragmenter::~Defragmenter()
+	{
+		if (_passPending)
+			endPass();
+		if (_context != VK_NULL_HANDLE)
+			finish();
+		_allocator._defragmenter = nullptr;
+	}
+
+	void Defragmenter::start()
+	{
+		if (isRunning())
+			return;
+		VmaDefragmentationInfo defragmentationInfo = {};
+		defragmentationInfo.maxBytesPerPass = _maxBytesPerPass;
+		defragmentationInfo.maxAllocationsPerPass = _maxAllocationsPerPass;
+		if (vmaBeginDefragmentation(_allocator._allocator, &defragmentationInfo, &_context) != VK_SUCCESS)
+			throw std::runtime_error("VMA : Unable to begin defragmentation");
+		_statistics = {};
+	}
+
+	bool Defragmenter::update(CommandBuffer& commandBuffer)
+	{
+		if (!isRunning())
+			return false;
+		auto start = std::chrono::steady_clock::now();
+		bool finished = false;
+		if (_passPending)
+		{
+			// The frame of the copies and the ones recorded before it have all been waited on
+			if (*_passExpired)
+				finished = endPass();
+		}
+		else
+			finished = beginPass(commandBuffer);
+		if (finished)
+			finish();
+		_statistics.time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return finished;
+	}
+
+	bool Defragmenter::isRunning() const
+	{
+		return _context != VK_NULL_HANDLE;
+	}
+
+	const Defragmenter::Statistics& Defragmenter::getStatistics() const
+	{
+		return _statistics;
+	}
+
+	bool Defragmenter::abandon(VmaAllocation allocation)
+	{
+		if (!_passPending)
+			return false;
+		for (std::uint32_t i = 0; i < _pass.moveCount; ++i)
+		{
+			VmaDefragmentationMove& move = _pass.pMoves[i];
+			if (move.srcAllocation != allocation)
+				continue;
+			// VMA frees both the old and the new place at the end of the pass
+			move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_DESTROY;
+			return true;
+		}
+		return false;
+	}
+
+	bool Defragmenter::beginPass(CommandBuffer& commandBuffer)
+	{
+		VkResult result = vmaBeginDefragmentationPass(_allocator._allocator, _context, &_pass);
+		if (result == VK_SUCCESS)
+			return true;
+		if (result != VK_INCOMPLETE)
+			throw std::runtime_error("VMA : Unable to begin defragmentation pass");
+
+		bool copied = false;
+		for (std::uint32_t i = 0; i < _pass.moveCount; ++i)
+		{
+			VmaDefragmentationMove& move = _pass.pMoves[i];
+			VmaAllocationInfo allocationInfo = {};
+			vmaGetAllocationInfo(_allocator._allocator, move.srcAllocation, &allocationInfo);
+			auto* buffer = static_cast<AllocatedBuffer*>(allocationInfo.pUserData);
+			if (buffer == nullptr || buffer->isMapped())
+			{
+				move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+				continue;
+			}
+			VkBufferCreateInfo bufferInfo = {};
+			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bufferInfo.size = buffer->getSize();
+			bufferInfo.usage = buffer->getUsage();
+			VkBuffer newBuffer = VK_NULL_HANDLE;
+			if (vmaCreateAliasingBuffer(_allocator._allocator, move.dstTmpAllocation, &bufferInfo, &newBuffer) !=
+				VK_SUCCESS)
+			{
+				move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+				continue;
+			}
+			if (!copied)
+			{
+				// Uploads and compute writes of the previous submissions must land before the copies read them
+				commandBuffer.memoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+						VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+						VK_ACCESS_TRANSFER_READ_BIT);
+				copied = true;
+			}
+			VkBufferCopy region = { 0, 0, buffer->getSize() };
+			commandBuffer.copyBuffer(buffer->_buffer, newBuffer, { &region, 1 });
+			// Only the handle goes, the old memory is released by the end of the pass
+			VkBuffer oldBuffer = std::exchange(buffer->_buffer, newBuffer);
+			_deletionQueue.push([allocator = _allocator._allocator, oldBuffer]()
+			{
+				vmaDestroyBuffer(allocator, oldBuffer, VK_NULL_HANDLE);
+			});
+		}
+		_passPending = true;
+		if (!copied)
+			return endPass();
+		// Queued after the old buffers, so the pass ends in the frame that destroys them
+		_passExpired = std::make_shared<bool>(false);
+		_deletionQueue.push([passExpired = _passExpired]()
+		{
+			*passExpired = true;
+		});
+		commandBuffer.memoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+				VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT |
+				VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
+				VK_PIPELINE_STAGE_TRANSFER_BIT,
+				VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
+				VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT |
+				VK_ACCESS_TRANSFER_WRITE_BIT);
+		return false;
+	}
+
+	bool Defragmenter::endPass()
+	{
+		VkResult result = vmaEndDefragmentationPass(_allocator._allocator, _context, &_pass);
+		_pass = {};
+		_passPending = false;
+		++_statistics.passCount;
+		return result == VK_SUCCESS;
+	}
+
+	void Defragmenter::finish()
+	{
+		VmaDefragmentationStats stats = {};
+		vmaEndDefragmentation(_allocator._allocator, _context, &stats);
+		_context = VK_NULL_HANDLE;
+		_statistics.bytesMoved = stats.bytesMoved;
+		_statistics.bytesFreed = stats.bytesFreed;
+		_statistics.allocationsMoved = stats.allocationsMoved;
+		_statistics.blocksFreed = stats.deviceMemoryBlocksFreed;
+	}
+} // Concerto::Graphics::Wrapper
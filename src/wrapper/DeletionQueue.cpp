@@ -0,0 +1,65 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/DeletionQueue.hpp"
+
+#include <vector>
+
+namespace Concerto::Graphics::Wrapper
+{
+	DeletionQueue::DeletionQueue(std::size_t frameCount) : _frameCount(frameCount), _frame(0)
+	{
+	}
+
+	DeletionQueue::~DeletionQueue()
+	{
+		flush();
+	}
+
+	void DeletionQueue::beginFrame()
+	{
+		std::vector<std::unique_ptr<Retired>> expired;
+		{
+			std::lock_guard lock(_mutex);
+			++_frame;
+			// Entries are in retirement order, so the expired ones are at the front
+			while (!_entries.empty() && _entries.front().frame + _frameCount <= _frame)
+			{
+				expired.push_back(std::move(_entries.front().retired));
+				_entries.pop_front();
+			}
+		}
+		// Destroyed outside of the lock, a retired object may retire others
+		for (auto& retired : expired)
+			retired.reset();
+	}
+
+	void DeletionQueue::flush()
+	{
+		while (true)
+		{
+			std::deque<Entry> entries;
+			{
+				std::lock_guard lock(_mutex);
+				entries.swap(_entries);
+			}
+			if (entries.empty())
+				return;
+			for (Entry& entry : entries)
+				entry.retired.reset();
+		}
+	}
+
+	std::size_t DeletionQueue::getPendingCount() const
+	{
+		std::lock_guard lock(_mutex);
+		return _entries.size();
+	}
+
+	void DeletionQueue::enqueue(std::unique_ptr<Retired> retired)
+	{
+		std::lock_guard lock(_mutex);
+		_entries.push_back({ _frame, std::move(retired) });
+	}
+} // Concerto::Graphics::Wrapper
@@ -4,6 +4,7 @@
 
 
 #include "wrapper/Descriptor.hpp"
+#include "wrapper/HostAllocator.hpp"
 #include <cstdint>
 #include <stdexcept>
 
@@ -18,7 +19,7 @@ namespace Concerto::Graphics::Wrapper
 		pool_info.maxSets = 10;
 		pool_info.poolSizeCount = (std::uint32_t)poolSizes.size();
 		pool_info.pPoolSizes = poolSizes.data();
-		if (vkCreateDescriptorPool(device, &pool_info, nullptr, &_pool) != VK_SUCCESS)
+		if (vkCreateDescriptorPool(device, &pool_info, HostAllocator::getCallbacks(), &_pool) != VK_SUCCESS)
 		{
 			throw std::runtime_error("failed to create descriptor pool!");
 		}
@@ -4,6 +4,7 @@
 
 
 #include "wrapper/DescriptorPool.hpp"
+#include "wrapper/HostAllocator.hpp"
 #include <stdexcept>
 
 namespace Concerto::Graphics::Wrapper
@@ -17,7 +18,7 @@ namespace Concerto::Graphics::Wrapper
 		pool_info.maxSets = 10;
 		pool_info.poolSizeCount = poolSizes.size();
 		pool_info.pPoolSizes = poolSizes.data();
-		if (vkCreateDescriptorPool(device, &pool_info, nullptr, &_pool) != VK_SUCCESS)
+		if (vkCreateDescriptorPool(device, &pool_info, HostAllocator::getCallbacks(), &_pool) != VK_SUCCESS)
 		{
 			throw std::runtime_error("Failed to create descriptor pool");
 		}
@@ -25,7 +26,7 @@ namespace Concerto::Graphics::Wrapper
 
 	DescriptorPool::~DescriptorPool()
 	{
-		vkDestroyDescriptorPool(_device, _pool, nullptr);
+		vkDestroyDescriptorPool(_device, _pool, HostAllocator::getCallbacks());
 		_pool = VK_NULL_HANDLE;
 	}
 
@@ -4,6 +4,7 @@
 
 
 #include "wrapper/DescriptorSetLayout.hpp"
+#include "wrapper/HostAllocator.hpp"
 #include <stdexcept>
 #include <iostream>
 namespace Concerto::Graphics::Wrapper
@@ -18,7 +19,7 @@ namespace Concerto::Graphics::Wrapper
 		createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 		createInfo.pBindings = bindings.data();
 		createInfo.bindingCount = bindings.size();
-		if (vkCreateDescriptorSetLayout(device, &createInfo, nullptr, &_layout) != VK_SUCCESS)
+		if (vkCreateDescriptorSetLayout(device, &createInfo, HostAllocator::getCallbacks(), &_layout) != VK_SUCCESS)
 		{
 			throw std::runtime_error("failed to create descriptor set layout!");
 		}
@@ -26,7 +27,7 @@ namespace Concerto::Graphics::Wrapper
 
 	DescriptorSetLayout::~DescriptorSetLayout()
 	{
-		vkDestroyDescriptorSetLayout(_device, _layout, nullptr);
+		vkDestroyDescriptorSetLayout(_device, _layout, HostAllocator::getCallbacks());
 		_layout = VK_NULL_HANDLE;
 		std::cout << "~DescriptorSetLayout" << std::endl;
 	}
@@ -4,6 +4,7 @@
 
 
 #include "wrapper/Fence.hpp"
+#include "wrapper/HostAllocator.hpp"
 #include <stdexcept>
 namespace Concerto::Graphics::Wrapper
 {
@@ -14,7 +15,7 @@ namespace Concerto::Graphics::Wrapper
 		info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
 		info.pNext = nullptr;
 		info.flags = signaled ? VK_FENCE_CREATE_SIGNALED_BIT : 0;
-		if (vkCreateFence(_device, &info, nullptr, &_fence) != VK_SUCCESS)
+		if (vkCreateFence(_device, &info, HostAllocator::getCallbacks(), &_fence) != VK_SUCCESS)
 		{
 			throw std::runtime_error("Failed to create fence");
 		}
@@ -22,7 +23,7 @@ namespace Concerto::Graphics::Wrapper
 
 	Fence::~Fence()
 	{
-		vkDestroyFence(_device, _fence, nullptr);
+		vkDestroyFence(_device, _fence, HostAllocator::getCallbacks());
 		_fence = VK_NULL_HANDLE;
 	}
 
@@ -46,4 +47,9 @@ namespace Concerto::Graphics::Wrapper
 			throw std::runtime_error("vkResetFences fail");
 		}
 	}
+
+	bool Fence::isSignaled() const
+	{
+		return vkGetFenceStatus(_device, _fence) == VK_SUCCESS;
+	}
 } // namespace Concerto::Graphics::Wrapper
\ No newline at end of file
@@ -0,0 +1,102 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/FrameAllocator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+
+namespace Concerto::Graphics::Wrapper
+{
+	FrameAllocator::FrameAllocator(Allocator& allocator, const VkPhysicalDeviceLimits& limits, std::size_t frameCount,
+			std::size_t size, std::size_t maxDescriptorRange) : _buffer(allocator, size + maxDescriptorRange,
+																	  VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+																	  VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+																	  VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+																	  VMA_MEMORY_USAGE_CPU_TO_GPU,
+																	  VMA_ALLOCATION_CREATE_MAPPED_BIT),
+																  _data(nullptr),
+																  _size(size),
+																  _uniformAlignment(std::max<std::size_t>(
+																		  limits.minUniformBufferOffsetAlignment, 1)),
+																  _storageAlignment(std::max<std::size_t>(
+																		  limits.minStorageBufferOffsetAlignment, 1)),
+																  _frameUsed(frameCount, 0),
+																  _currentFrame(0),
+																  _frameStart(0),
+																  _head(0),
+																  _used(0)
+	{
+		if (frameCount == 0 || size == 0)
+			throw std::runtime_error("FrameAllocator: empty ring");
+		// Dynamic offsets are 32 bits
+		if (size + maxDescriptorRange > std::numeric_limits<std::uint32_t>::max())
+			throw std::runtime_error("FrameAllocator: ring larger than 4 GB");
+		if (!_buffer.isMapped())
+			throw std::runtime_error("FrameAllocator: unable to map the ring");
+		_data = _buffer.getMappedData().data();
+	}
+
+	void FrameAllocator::beginFrame(std::size_t frameIndex)
+	{
+		assert(frameIndex < _frameUsed.size());
+		_used -= _frameUsed[frameIndex];
+		_frameUsed[frameIndex] = 0;
+		_currentFrame = frameIndex;
+		if (_used == 0)
+			_head = 0;
+		_frameStart = _head;
+	}
+
+	FrameAllocation FrameAllocator::allocateUniform(std::size_t size)
+	{
+		return allocate(size, _uniformAlignment);
+	}
+
+	FrameAllocation FrameAllocator::allocateStorage(std::size_t size)
+	{
+		return allocate(size, _storageAlignment);
+	}
+
+	FrameAllocation FrameAllocator::allocateIndirect(std::size_t size)
+	{
+		// Indirect commands are read as 32 bit words, the offset of the draw calls must be a multiple of 4
+		return allocate(size, alignof(std::uint32_t));
+	}
+
+	FrameAllocation FrameAllocator::allocate(std::size_t size, std::size_t alignment)
+	{
+		assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+		std::size_t offset = (_head + alignment - 1) & ~(alignment - 1);
+		if (offset + size > _size)
+			offset = 0; // the end of the ring is skipped and given back with this frame
+		const std::size_t consumed = offset >= _head ? offset + size - _head : _size - _head + offset + size;
+		if (_used + consumed > _size)
+			throw std::runtime_error("FrameAllocator: ring exhausted by the frames in flight");
+		_head = offset + size;
+		_used += consumed;
+		_frameUsed[_currentFrame] += consumed;
+		return { _buffer._buffer, static_cast<std::uint32_t>(offset), _data + offset };
+	}
+
+	void FrameAllocator::flush() const
+	{
+		if (_head >= _frameStart && _frameUsed[_currentFrame] <= _head - _frameStart)
+			_buffer.flush(_frameStart, _head - _frameStart);
+		else
+			_buffer.flush(0, _size); // the frame wrapped around the end of the ring
+	}
+
+	VkBuffer FrameAllocator::getBuffer() const
+	{
+		return _buffer._buffer;
+	}
+
+	std::size_t FrameAllocator::getUsedSize() const
+	{
+		return _used;
+	}
+} // Concerto::Graphics::Wrapper
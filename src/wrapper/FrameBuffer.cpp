@@ -4,6 +4,7 @@
 
 
 #include "wrapper/FrameBuffer.hpp"
+#include "wrapper/HostAllocator.hpp"
 #include "wrapper/VulkanInitializer.hpp"
 namespace Concerto::Graphics::Wrapper
 {
@@ -19,7 +20,7 @@ namespace Concerto::Graphics::Wrapper
 
 			fb_info.pAttachments = attachments;
 			fb_info.attachmentCount = 2;
-			if(vkCreateFramebuffer(device, &fb_info, nullptr, &_frameBuffers[i]) != VK_SUCCESS)
+			if(vkCreateFramebuffer(device, &fb_info, HostAllocator::getCallbacks(), &_frameBuffers[i]) != VK_SUCCESS)
 			{
 				throw std::runtime_error("failed to create framebuffer!");
 			}
@@ -30,8 +31,8 @@ namespace Concerto::Graphics::Wrapper
 	{
 		for (int i = 0; i < _frameBuffers.size(); i++)
 		{
-			vkDestroyFramebuffer(_device, _frameBuffers[i], nullptr);
-			vkDestroyImageView(_device, _swapchain.getImageViews()[i], nullptr);
+			vkDestroyFramebuffer(_device, _frameBuffers[i], HostAllocator::getCallbacks());
+			vkDestroyImageView(_device, _swapchain.getImageViews()[i], HostAllocator::getCallbacks());
 		}
 	}
 
@@ -0,0 +1,110 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/GeometryArena.hpp"
+
+#include <cassert>
+#include "glm/glm.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	GeometryArena::GeometryArena(Allocator& allocator, VertexFormat vertexFormat, std::uint32_t vertexCapacity,
+			std::uint32_t indexCapacity) : _vertexFormat(vertexFormat),
+										   _vertexCapacity(vertexCapacity),
+										   _vertexAllocator(vertexCapacity),
+										   _indexAllocator(indexCapacity),
+										   _vertexBuffer(allocator, vertexCapacity * getVertexStride(vertexFormat),
+												   VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+												   VMA_MEMORY_USAGE_GPU_ONLY),
+										   _indexBuffer(allocator, indexCapacity * sizeof(std::uint32_t),
+												   VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+												   VMA_MEMORY_USAGE_GPU_ONLY)
+	{
+	}
+
+	std::optional<GeometryArena::Range> GeometryArena::allocateVertices(std::uint32_t count)
+	{
+		std::optional<std::uint64_t> offset = _vertexAllocator.allocate(count);
+		if (!offset)
+			return std::nullopt;
+		return Range{ static_cast<std::uint32_t>(*offset), count };
+	}
+
+	std::optional<GeometryArena::Range> GeometryArena::allocateIndices(std::uint32_t count)
+	{
+		std::optional<std::uint64_t> offset = _indexAllocator.allocate(count);
+		if (!offset)
+			return std::nullopt;
+		return Range{ static_cast<std::uint32_t>(*offset), count };
+	}
+
+	void GeometryArena::freeVertices(const Range& range)
+	{
+		_vertexAllocator.free(range.offset, range.count);
+	}
+
+	void GeometryArena::freeIndices(const Range& range)
+	{
+		_indexAllocator.free(range.offset, range.count);
+	}
+
+	void GeometryArena::uploadVertices(UploadContext& uploadContext, const Range& range,
+			std::span<const std::byte> data)
+	{
+		assert(data.size() == range.count * getVertexStride(_vertexFormat));
+		if (_vertexFormat != VertexFormat::Split)
+		{
+			uploadContext.upload(_vertexBuffer, range.offset * getVertexStride(_vertexFormat), data);
+			return;
+		}
+		const std::size_t positionsSize = range.count * sizeof(glm::vec3);
+		uploadContext.upload(_vertexBuffer, range.offset * sizeof(glm::vec3), data.first(positionsSize));
+		uploadContext.upload(_vertexBuffer,
+				_vertexCapacity * sizeof(glm::vec3) + range.offset * sizeof(VertexAttributes),
+				data.subspan(positionsSize));
+	}
+
+	void GeometryArena::uploadIndices(UploadContext& uploadContext, const Range& range,
+			std::span<const std::uint32_t> indices)
+	{
+		assert(indices.size() == range.count);
+		uploadContext.upload(_indexBuffer, range.offset * sizeof(std::uint32_t), std::as_bytes(indices));
+	}
+
+	void GeometryArena::bind(CommandBuffer& commandBuffer) const
+	{
+		if (_vertexFormat == VertexFormat::Split)
+		{
+			const VkBuffer buffers[] = { _vertexBuffer._buffer, _vertexBuffer._buffer };
+			const VkDeviceSize offsets[] = { 0, _vertexCapacity * sizeof(glm::vec3) };
+			commandBuffer.bindVertexBuffers(0, buffers, offsets);
+		}
+		else
+			commandBuffer.bindVertexBuffers(_vertexBuffer);
+		commandBuffer.bindIndexBuffer(_indexBuffer);
+	}
+
+	void GeometryArena::bindPositions(CommandBuffer& commandBuffer) const
+	{
+		assert(_vertexFormat == VertexFormat::Split);
+		//the positions stream starts at the beginning of the vertex buffer
+		commandBuffer.bindVertexBuffers(_vertexBuffer);
+		commandBuffer.bindIndexBuffer(_indexBuffer);
+	}
+
+	VertexFormat GeometryArena::getVertexFormat() const
+	{
+		return _vertexFormat;
+	}
+
+	std::uint32_t GeometryArena::getFreeVertexCount() const
+	{
+		return static_cast<std::uint32_t>(_vertexAllocator.getFreeSize());
+	}
+
+	std::uint32_t GeometryArena::getFreeIndexCount() const
+	{
+		return static_cast<std::uint32_t>(_indexAllocator.getFreeSize());
+	}
+} // Concerto::Graphics::Wrapper
@@ -0,0 +1,626 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/GltfParser.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include "nlohmann/json.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	namespace
+	{
+		using Json = nlohmann::json;
+		using Accessor = GltfParser::Accessor;
+
+		constexpr std::uint32_t GlbMagic = 0x46546C67; // "glTF"
+		constexpr std::uint32_t GlbVersion = 2;
+		constexpr std::uint32_t ChunkJson = 0x4E4F534A; // "JSON"
+		constexpr std::uint32_t ChunkBin = 0x004E4942; // "BIN\0"
+		constexpr std::uint32_t ModeTriangles = 4;
+
+		enum ComponentType : std::uint32_t
+		{
+			Byte = 5120,
+			UnsignedByte = 5121,
+			Short = 5122,
+			UnsignedShort = 5123,
+			UnsignedInt = 5125,
+			Float = 5126
+		};
+
+		/**
+		 * @brief Thrown for valid files using a feature this parser does not implement
+		 */
+		struct UnsupportedError : std::runtime_error
+		{
+			using std::runtime_error::runtime_error;
+		};
+
+		std::uint32_t readUint32(const std::byte* data)
+		{
+			std::uint32_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		std::size_t getComponentSize(std::uint32_t componentType)
+		{
+			switch (componentType)
+			{
+			case Byte:
+			case UnsignedByte:
+				return 1;
+			case Short:
+			case UnsignedShort:
+				return 2;
+			case UnsignedInt:
+			case Float:
+				return 4;
+			default:
+				return 0;
+			}
+		}
+
+		std::uint32_t getComponentCount(const std::string& type)
+		{
+			if (type == "SCALAR")
+				return 1;
+			if (type == "VEC2")
+				return 2;
+			if (type == "VEC3")
+				return 3;
+			if (type == "VEC4")
+				return 4;
+			return 0;
+		}
+
+		float readComponent(const std::byte* data, std::uint32_t componentType, bool normalized)
+		{
+			switch (componentType)
+			{
+			case Float:
+			{
+				float value;
+				std::memcpy(&value, data, sizeof(value));
+				return value;
+			}
+			case UnsignedByte:
+				return static_cast<float>(std::to_integer<std::uint8_t>(*data)) / (normalized ? 255.f : 1.f);
+			case Byte:
+			{
+				float value = static_cast<float>(static_cast<std::int8_t>(std::to_integer<std::uint8_t>(*data)));
+				return normalized ? std::max(value / 127.f, -1.f) : value;
+			}
+			case UnsignedShort:
+			{
+				std::uint16_t value;
+				std::memcpy(&value, data, sizeof(value));
+				return static_cast<float>(value) / (normalized ? 65535.f : 1.f);
+			}
+			case Short:
+			{
+				std::int16_t value;
+				std::memcpy(&value, data, sizeof(value));
+				return normalized ? std::max(static_cast<float>(value) / 32767.f, -1.f) : static_cast<float>(value);
+			}
+			default:
+				return static_cast<float>(readUint32(data));
+			}
+		}
+
+		void readFloats(const Accessor& accessor, std::size_t index, float* out, std::uint32_t count)
+		{
+			const std::byte* element = accessor.data + index * accessor.stride;
+			const std::size_t componentSize = getComponentSize(accessor.componentType);
+			count = std::min(count, accessor.componentCount);
+			for (std::uint32_t i = 0; i < count; ++i)
+				out[i] = readComponent(element + i * componentSize, accessor.componentType, accessor.normalized);
+		}
+
+		glm::vec3 readVec3(const Accessor& accessor, std::size_t index)
+		{
+			float values[3] = { 0.f, 0.f, 0.f };
+			readFloats(accessor, index, values, 3);
+			return glm::vec3(values[0], values[1], values[2]);
+		}
+
+		glm::vec2 readVec2(const Accessor& accessor, std::size_t index)
+		{
+			float values[2] = { 0.f, 0.f };
+			readFloats(accessor, index, values, 2);
+			return glm::vec2(values[0], values[1]);
+		}
+
+		std::uint32_t readIndex(const Accessor& accessor, std::size_t index)
+		{
+			const std::byte* element = accessor.data + index * accessor.stride;
+			switch (accessor.componentType)
+			{
+			case UnsignedByte:
+				return std::to_integer<std::uint32_t>(*element);
+			case UnsignedShort:
+			{
+				std::uint16_t value;
+				std::memcpy(&value, element, sizeof(value));
+				return value;
+			}
+			default:
+				return readUint32(element);
+			}
+		}
+
+		/**
+		 * @return true if the accessor can be copied as a packed array of components floats
+		 */
+		bool isTightFloat(const Accessor& accessor, std::uint32_t components)
+		{
+			return accessor.componentType == Float && accessor.componentCount == components &&
+				   accessor.stride == components * sizeof(float);
+		}
+
+		bool isIdentity(const glm::mat4& matrix)
+		{
+			for (int column = 0; column < 4; ++column)
+				for (int row = 0; row < 4; ++row)
+					if (matrix[column][row] != (column == row ? 1.f : 0.f))
+						return false;
+			return true;
+		}
+
+		float getDeterminant(const glm::mat4& m)
+		{
+			return m[0][0] * (m[1][1] * m[2][2] - m[2][1] * m[1][2]) -
+				   m[1][0] * (m[0][1] * m[2][2] - m[2][1] * m[0][2]) +
+				   m[2][0] * (m[0][1] * m[1][2] - m[1][1] * m[0][2]);
+		}
+
+		glm::mat4 getNodeTransform(const Json& node)
+		{
+			glm::mat4 transform(1.f);
+			if (node.contains("matrix"))
+			{
+				const Json& matrix = node.at("matrix");
+				if (matrix.size() != 16)
+					throw std::runtime_error("node matrix without 16 values");
+				// Column major like glm
+				for (int column = 0; column < 4; ++column)
+					for (int row = 0; row < 4; ++row)
+						transform[column][row] = matrix.at(column * 4 + row).get<float>();
+				return transform;
+			}
+			if (node.contains("scale"))
+			{
+				const Json& scale = node.at("scale");
+				for (int i = 0; i < 3; ++i)
+					transform[i][i] = scale.at(i).get<float>();
+			}
+			if (node.contains("rotation"))
+			{
+				const Json& rotation = node.at("rotation");
+				const float x = rotation.at(0).get<float>();
+				const float y = rotation.at(1).get<float>();
+				const float z = rotation.at(2).get<float>();
+				const float w = rotation.at(3).get<float>();
+				glm::mat4 rotationMatrix(1.f);
+				rotationMatrix[0] = glm::vec4(1.f - 2.f * (y * y + z * z), 2.f * (x * y + w * z), 2.f * (x * z - w * y), 0.f);
+				rotationMatrix[1] = glm::vec4(2.f * (x * y - w * z), 1.f - 2.f * (x * x + z * z), 2.f * (y * z + w * x), 0.f);
+				rotationMatrix[2] = glm::vec4(2.f * (x * z + w * y), 2.f * (y * z - w * x), 1.f - 2.f * (x * x + y * y), 0.f);
+				transform = rotationMatrix * transform;
+			}
+			if (node.contains("translation"))
+			{
+				const Json& translation = node.at("translation");
+				transform[3] = glm::vec4(translation.at(0).get<float>(), translation.at(1).get<float>(),
+						translation.at(2).get<float>(), 1.f);
+			}
+			return transform;
+		}
+
+		Accessor parseAccessor(const Json& document, std::span<const std::byte> bin, std::size_t index)
+		{
+			const Json& accessor = document.at("accessors").at(index);
+			if (accessor.contains("sparse"))
+				throw UnsupportedError("sparse accessor");
+			if (!accessor.contains("bufferView"))
+				throw UnsupportedError("accessor without buffer view");
+			const Json& bufferView = document.at("bufferViews").at(accessor.at("bufferView").get<std::size_t>());
+			const std::size_t buffer = bufferView.at("buffer").get<std::size_t>();
+			if (buffer != 0 || document.at("buffers").at(0).contains("uri"))
+				throw UnsupportedError("buffer stored outside of the GLB");
+
+			Accessor result{};
+			result.count = accessor.at("count").get<std::size_t>();
+			result.componentType = accessor.at("componentType").get<std::uint32_t>();
+			result.componentCount = getComponentCount(accessor.at("type").get<std::string>());
+			result.normalized = accessor.value("normalized", false);
+			const std::size_t elementSize = getComponentSize(result.componentType) * result.componentCount;
+			if (elementSize == 0)
+				throw std::runtime_error("invalid accessor type");
+			result.stride = bufferView.value("byteStride", elementSize);
+			if (result.stride < elementSize)
+				throw std::runtime_error("accessor elements overlap");
+
+			const std::size_t viewOffset = bufferView.value("byteOffset", std::size_t(0));
+			const std::size_t viewLength = bufferView.at("byteLength").get<std::size_t>();
+			const std::size_t offset = accessor.value("byteOffset", std::size_t(0));
+			if (viewOffset > bin.size() || viewLength > bin.size() - viewOffset)
+				throw std::runtime_error("buffer view outside of the binary chunk");
+			if (result.count != 0 &&
+				(result.count - 1 > (std::numeric_limits<std::size_t>::max() - elementSize - offset) / result.stride ||
+				 offset + (result.count - 1) * result.stride + elementSize > viewLength))
+				throw std::runtime_error("accessor outside of its buffer view");
+			result.data = bin.data() + viewOffset + offset;
+			return result;
+		}
+
+		BoundingBox transformBoundingBox(const BoundingBox& box, const glm::mat4& transform)
+		{
+			BoundingBox result{ glm::vec3(std::numeric_limits<float>::max()),
+								glm::vec3(-std::numeric_limits<float>::max()) };
+			for (int corner = 0; corner < 8; ++corner)
+			{
+				glm::vec3 position((corner & 1) ? box.max.x : box.min.x, (corner & 2) ? box.max.y : box.min.y,
+						(corner & 4) ? box.max.z : box.min.z);
+				position = glm::vec3(transform * glm::vec4(position, 1.f));
+				result.min = glm::min(result.min, position);
+				result.max = glm::max(result.max, position);
+			}
+			return result;
+		}
+
+		std::vector<glm::vec3> computeNormals(const Accessor& positions, const std::optional<Accessor>& indices)
+		{
+			// Area weighted sum of the normals of the triangles using each vertex
+			std::vector<glm::vec3> normals(positions.count, glm::vec3(0.f));
+			const std::size_t cornerCount = indices ? indices->count : positions.count;
+			for (std::size_t corner = 0; corner + 2 < cornerCount; corner += 3)
+			{
+				std::uint32_t triangle[3];
+				for (std::uint32_t i = 0; i < 3; ++i)
+					triangle[i] = indices ? readIndex(*indices, corner + i) : static_cast<std::uint32_t>(corner + i);
+				const glm::vec3 a = readVec3(positions, triangle[0]);
+				const glm::vec3 normal = glm::cross(readVec3(positions, triangle[1]) - a,
+						readVec3(positions, triangle[2]) - a);
+				for (std::uint32_t vertex: triangle)
+					normals[vertex] += normal;
+			}
+			for (glm::vec3& normal: normals)
+			{
+				float length = glm::length(normal);
+				normal = length > 0.f ? normal / length : glm::vec3(0.f, 1.f, 0.f);
+			}
+			return normals;
+		}
+	}
+
+	GltfParser::Result GltfParser::parse(const std::string& fileName)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		_primitives.clear();
+		_instances.clear();
+		_vertexCount = 0;
+		_indexCount = 0;
+		if (!_file.open(fileName))
+		{
+			std::cerr << "GltfParser: unable to open " << fileName << std::endl;
+			return Result::Error;
+		}
+		const std::byte* data = _file.data();
+		const std::size_t size = _file.size();
+		if (size < 20 || readUint32(data) != GlbMagic || readUint32(data + 4) != GlbVersion ||
+			readUint32(data + 8) > size || readUint32(data + 16) != ChunkJson)
+		{
+			std::cerr << "GltfParser: " << fileName << " is not a glTF 2.0 binary file" << std::endl;
+			return Result::Error;
+		}
+		const std::size_t length = readUint32(data + 8);
+		const std::size_t jsonLength = readUint32(data + 12);
+		if (jsonLength > length - 20)
+		{
+			std::cerr << "GltfParser: truncated JSON chunk in " << fileName << std::endl;
+			return Result::Error;
+		}
+		const auto* json = reinterpret_cast<const char*>(data + 20);
+		std::span<const std::byte> bin;
+		const std::size_t binHeader = 20 + ((jsonLength + 3) & ~std::size_t(3));
+		if (binHeader + 8 <= length && readUint32(data + binHeader + 4) == ChunkBin)
+		{
+			const std::size_t binLength = readUint32(data + binHeader);
+			if (binLength > length - binHeader - 8)
+			{
+				std::cerr << "GltfParser: truncated binary chunk in " << fileName << std::endl;
+				return Result::Error;
+			}
+			bin = std::span(data + binHeader + 8, binLength);
+		}
+
+		try
+		{
+			const Json document = Json::parse(json, json + jsonLength);
+
+			// Primitives are parsed once per mesh and shared by the nodes instancing the mesh
+			std::vector<std::vector<std::size_t>> meshPrimitives;
+			const Json& meshes = document.value("meshes", Json::array());
+			meshPrimitives.reserve(meshes.size());
+			for (const Json& mesh: meshes)
+			{
+				std::vector<std::size_t>& primitives = meshPrimitives.emplace_back();
+				for (const Json& primitive: mesh.at("primitives"))
+				{
+					if (primitive.value("mode", ModeTriangles) != ModeTriangles)
+					{
+						std::cout << "GltfParser: skipping a primitive that is not a triangle list in " << fileName
+								  << std::endl;
+						continue;
+					}
+					const Json& attributes = primitive.at("attributes");
+					Primitive parsed{};
+					parsed.positions = parseAccessor(document, bin, attributes.at("POSITION").get<std::size_t>());
+					if (parsed.positions.componentCount != 3)
+						throw std::runtime_error("POSITION is not a VEC3");
+					const std::size_t vertexCount = parsed.positions.count;
+					auto parseAttribute = [&](const char* name, std::uint32_t minComponents, std::uint32_t maxComponents)
+							-> std::optional<Accessor>
+					{
+						if (!attributes.contains(name))
+							return std::nullopt;
+						Accessor accessor = parseAccessor(document, bin, attributes.at(name).get<std::size_t>());
+						if (accessor.count != vertexCount || accessor.componentCount < minComponents ||
+							accessor.componentCount > maxComponents)
+							throw std::runtime_error(std::string("invalid ") + name + " accessor");
+						return accessor;
+					};
+					parsed.normals = parseAttribute("NORMAL", 3, 3);
+					parsed.colors = parseAttribute("COLOR_0", 3, 4);
+					parsed.uvs = parseAttribute("TEXCOORD_0", 2, 2);
+					if (primitive.contains("indices"))
+					{
+						parsed.indices = parseAccessor(document, bin, primitive.at("indices").get<std::size_t>());
+						if (parsed.indices->componentCount != 1 || parsed.indices->componentType == Byte ||
+							parsed.indices->componentType == Short || parsed.indices->componentType == Float)
+							throw std::runtime_error("invalid index accessor");
+						for (std::size_t i = 0; i < parsed.indices->count; ++i)
+							if (readIndex(*parsed.indices, i) >= vertexCount)
+								throw std::runtime_error("index out of range");
+					}
+
+					const Json& accessor = document.at("accessors").at(attributes.at("POSITION").get<std::size_t>());
+					if (accessor.contains("min") && accessor.contains("max"))
+					{
+						const Json& min = accessor.at("min");
+						const Json& max = accessor.at("max");
+						parsed.boundingBox = { glm::vec3(min.at(0).get<float>(), min.at(1).get<float>(), min.at(2).get<float>()),
+											   glm::vec3(max.at(0).get<float>(), max.at(1).get<float>(), max.at(2).get<float>()) };
+					}
+					else
+					{
+						parsed.boundingBox = { glm::vec3(std::numeric_limits<float>::max()),
+											   glm::vec3(-std::numeric_limits<float>::max()) };
+						for (std::size_t i = 0; i < vertexCount; ++i)
+						{
+							parsed.boundingBox.min = glm::min(parsed.boundingBox.min, readVec3(parsed.positions, i));
+							parsed.boundingBox.max = glm::max(parsed.boundingBox.max, readVec3(parsed.positions, i));
+						}
+					}
+					primitives.push_back(_primitives.size());
+					_primitives.push_back(parsed);
+				}
+			}
+
+			auto instanceMesh = [&](std::size_t mesh, const glm::mat4& transform)
+			{
+				for (std::size_t primitive: meshPrimitives.at(mesh))
+				{
+					_instances.push_back({ primitive, transform, isIdentity(transform) });
+					_vertexCount += _primitives[primitive].positions.count;
+					_indexCount += _primitives[primitive].indices ? _primitives[primitive].indices->count
+																   : _primitives[primitive].positions.count;
+				}
+			};
+
+			if (document.contains("scenes"))
+			{
+				const Json& nodes = document.value("nodes", Json::array());
+				const Json& scene = document.at("scenes").at(document.value("scene", std::size_t(0)));
+				// Depth first walk of the scene, the depth bound protects against cycles in broken files
+				// Nodes are pushed in reverse so the meshes keep the order of the file
+				std::vector<std::pair<std::size_t, glm::mat4>> stack;
+				const Json& roots = scene.value("nodes", Json::array());
+				for (auto root = roots.rbegin(); root != roots.rend(); ++root)
+					stack.emplace_back(root->get<std::size_t>(), glm::mat4(1.f));
+				std::size_t visited = 0;
+				while (!stack.empty())
+				{
+					auto [index, parentTransform] = stack.back();
+					stack.pop_back();
+					if (++visited > nodes.size() * 16)
+						throw std::runtime_error("node hierarchy is not a tree");
+					const Json& node = nodes.at(index);
+					glm::mat4 transform = parentTransform * getNodeTransform(node);
+					if (node.contains("mesh"))
+						instanceMesh(node.at("mesh").get<std::size_t>(), transform);
+					const Json& children = node.value("children", Json::array());
+					for (auto child = children.rbegin(); child != children.rend(); ++child)
+						stack.emplace_back(child->get<std::size_t>(), transform);
+				}
+			}
+			else
+			{
+				for (std::size_t mesh = 0; mesh < meshPrimitives.size(); ++mesh)
+					instanceMesh(mesh, glm::mat4(1.f));
+			}
+		}
+		catch (const UnsupportedError& error)
+		{
+			std::cerr << "GltfParser: " << fileName << " uses an unsupported feature: " << error.what() << std::endl;
+			return Result::Unsupported;
+		}
+		catch (const std::exception& error)
+		{
+			std::cerr << "GltfParser: invalid file " << fileName << ": " << error.what() << std::endl;
+			return Result::Error;
+		}
+		if (_vertexCount > std::numeric_limits<std::uint32_t>::max())
+		{
+			std::cerr << "GltfParser: " << fileName << " has too many vertices for 32 bits indices" << std::endl;
+			return Result::Unsupported;
+		}
+
+		_parsedBytes = size;
+		_parseTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return Result::Success;
+	}
+
+	std::size_t GltfParser::getVertexCount() const
+	{
+		return _vertexCount;
+	}
+
+	std::size_t GltfParser::getIndexCount() const
+	{
+		return _indexCount;
+	}
+
+	BoundingBox GltfParser::getBoundingBox() const
+	{
+		if (_instances.empty())
+			return { glm::vec3(0.f), glm::vec3(0.f) };
+		BoundingBox box{ glm::vec3(std::numeric_limits<float>::max()), glm::vec3(-std::numeric_limits<float>::max()) };
+		for (const Instance& instance: _instances)
+		{
+			BoundingBox primitiveBox = _primitives[instance.primitive].boundingBox;
+			if (!instance.identity)
+				primitiveBox = transformBoundingBox(primitiveBox, instance.transform);
+			box.min = glm::min(box.min, primitiveBox.min);
+			box.max = glm::max(box.max, primitiveBox.max);
+		}
+		return box;
+	}
+
+	void GltfParser::readPositions(std::byte* out, std::size_t stride) const
+	{
+		for (const Instance& instance: _instances)
+		{
+			const Accessor& accessor = _primitives[instance.primitive].positions;
+			// Untransformed float positions are already laid out like a packed positions stream
+			if (instance.identity && stride == sizeof(glm::vec3) && isTightFloat(accessor, 3))
+				std::memcpy(out, accessor.data, accessor.count * sizeof(glm::vec3));
+			else
+			{
+				for (std::size_t i = 0; i < accessor.count; ++i)
+				{
+					glm::vec3 position = readVec3(accessor, i);
+					if (!instance.identity)
+						position = glm::vec3(instance.transform * glm::vec4(position, 1.f));
+					std::memcpy(out + i * stride, &position, sizeof(position));
+				}
+			}
+			out += accessor.count * stride;
+		}
+	}
+
+	template<typename Write>
+	void GltfParser::readAttributes(Write&& write) const
+	{
+		std::size_t base = 0;
+		for (const Instance& instance: _instances)
+		{
+			const Primitive& primitive = _primitives[instance.primitive];
+			std::vector<glm::vec3> generatedNormals;
+			if (!primitive.normals)
+				generatedNormals = computeNormals(primitive.positions, primitive.indices);
+			const glm::mat4 normalTransform = glm::transpose(glm::inverse(instance.transform));
+			for (std::size_t i = 0; i < primitive.positions.count; ++i)
+			{
+				VertexAttributes attributes{};
+				attributes.normal = primitive.normals ? readVec3(*primitive.normals, i) : generatedNormals[i];
+				if (!instance.identity)
+					attributes.normal = glm::normalize(glm::vec3(normalTransform * glm::vec4(attributes.normal, 0.f)));
+				// Like the OBJ loader, the normal stands in for a missing color
+				attributes.color = primitive.colors ? readVec3(*primitive.colors, i) : attributes.normal;
+				attributes.uv = primitive.uvs ? readVec2(*primitive.uvs, i) : glm::vec2(0.f);
+				write(base + i, attributes);
+			}
+			base += primitive.positions.count;
+		}
+	}
+
+	void GltfParser::readVertices(std::span<Vertex> vertices) const
+	{
+		assert(vertices.size() == _vertexCount);
+		readPositions(reinterpret_cast<std::byte*>(vertices.data()) + offsetof(Vertex, position), sizeof(Vertex));
+		readAttributes([&](std::size_t index, const VertexAttributes& attributes)
+		{
+			vertices[index].normal = attributes.normal;
+			vertices[index].color = attributes.color;
+			vertices[index].uv = attributes.uv;
+		});
+	}
+
+	void GltfParser::readVertices(std::span<glm::vec3> positions, std::span<VertexAttributes> attributes) const
+	{
+		assert(positions.size() == _vertexCount && attributes.size() == _vertexCount);
+		readPositions(reinterpret_cast<std::byte*>(positions.data()), sizeof(glm::vec3));
+		readAttributes([&](std::size_t index, const VertexAttributes& vertexAttributes)
+		{
+			attributes[index] = vertexAttributes;
+		});
+	}
+
+	void GltfParser::readIndices(std::span<std::uint32_t> indices) const
+	{
+		assert(indices.size() == _indexCount);
+		std::size_t vertexBase = 0;
+		std::size_t indexBase = 0;
+		for (const Instance& instance: _instances)
+		{
+			const Primitive& primitive = _primitives[instance.primitive];
+			const std::size_t count = primitive.indices ? primitive.indices->count : primitive.positions.count;
+			std::uint32_t* out = indices.data() + indexBase;
+			const auto base = static_cast<std::uint32_t>(vertexBase);
+			if (!primitive.indices)
+			{
+				for (std::size_t i = 0; i < count; ++i)
+					out[i] = base + static_cast<std::uint32_t>(i);
+			}
+			else if (base == 0 && primitive.indices->componentType == UnsignedInt &&
+					 primitive.indices->stride == sizeof(std::uint32_t))
+				std::memcpy(out, primitive.indices->data, count * sizeof(std::uint32_t));
+			else
+			{
+				for (std::size_t i = 0; i < count; ++i)
+					out[i] = base + readIndex(*primitive.indices, i);
+			}
+			// A mirroring transform turns the triangles inside out, swap two corners to keep their winding
+			if (!instance.identity && getDeterminant(instance.transform) < 0.f)
+				for (std::size_t i = 0; i + 2 < count; i += 3)
+					std::swap(out[i + 1], out[i + 2]);
+			vertexBase += primitive.positions.count;
+			indexBase += count;
+		}
+	}
+
+	std::size_t GltfParser::getPrimitiveCount() const
+	{
+		return _instances.size();
+	}
+
+	std::size_t GltfParser::getParsedBytes() const
+	{
+		return _parsedBytes;
+	}
+
+	double GltfParser::getParseTime() const
+	{
+		return _parseTime;
+	}
+} // Concerto::Graphics::Wrapper
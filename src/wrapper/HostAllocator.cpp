@@ -0,0 +1,275 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/HostAllocator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace Concerto::Graphics::Wrapper
+{
+	namespace
+	{
+		constexpr std::size_t MinAlignment = 16;
+
+		std::uintptr_t alignUp(std::uintptr_t value, std::size_t alignment)
+		{
+			return (value + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+		}
+
+		// References are the live allocations of the block, plus one while it is the block of its thread
+		struct Block
+		{
+			std::atomic<std::size_t> references;
+			std::size_t size;
+			std::size_t used;
+		};
+
+		constexpr std::size_t BlockHeaderSize = (sizeof(Block) + 63) & ~std::size_t(63);
+
+		// Stored right before each allocation
+		struct alignas(MinAlignment) AllocationHeader
+		{
+			Block* block; // nullptr if the allocation comes from malloc
+			void* base;
+			std::size_t size;
+			VkSystemAllocationScope scope;
+		};
+
+		AllocationHeader* getHeader(void* memory)
+		{
+			return reinterpret_cast<AllocationHeader*>(static_cast<std::byte*>(memory) - sizeof(AllocationHeader));
+		}
+
+		void releaseBlock(Block* block)
+		{
+			if (block->references.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				return;
+			block->~Block();
+			std::free(block);
+		}
+
+		struct ThreadArena
+		{
+			~ThreadArena()
+			{
+				if (block != nullptr)
+					releaseBlock(block);
+			}
+
+			void* bump(std::size_t size, std::size_t alignment)
+			{
+				auto* data = reinterpret_cast<std::byte*>(block) + BlockHeaderSize;
+				std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(data);
+				std::uintptr_t memory = alignUp(begin + block->used + sizeof(AllocationHeader), alignment);
+				if (memory + size > begin + block->size)
+					return nullptr;
+				block->used = memory + size - begin;
+				block->references.fetch_add(1, std::memory_order_relaxed);
+				return reinterpret_cast<void*>(memory);
+			}
+
+			void* allocate(std::size_t size, std::size_t alignment, std::size_t blockSize)
+			{
+				// Only this thread bumps the block, the others can only drop references
+				if (block != nullptr && block->references.load(std::memory_order_acquire) == 1)
+					block->used = 0;
+				void* memory = block != nullptr ? bump(size, alignment) : nullptr;
+				if (memory != nullptr)
+					return memory;
+				void* storage = std::malloc(BlockHeaderSize + blockSize);
+				if (storage == nullptr)
+					return nullptr;
+				if (block != nullptr)
+					releaseBlock(block);
+				block = new(storage) Block{ 1, blockSize, 0 };
+				return bump(size, alignment);
+			}
+
+			Block* block = nullptr;
+		};
+
+		thread_local ThreadArena threadArena;
+	}
+
+	HostAllocator* HostAllocator::_installed = nullptr;
+
+	HostAllocator::HostAllocator(std::size_t blockSize) : _blockSize(blockSize), _callbacks(), _counters()
+	{
+		assert(_installed == nullptr && "Only one HostAllocator can be installed");
+		_callbacks.pUserData = this;
+		_callbacks.pfnAllocation = &HostAllocator::allocation;
+		_callbacks.pfnReallocation = &HostAllocator::reallocation;
+		_callbacks.pfnFree = &HostAllocator::free;
+		_callbacks.pfnInternalAllocation = &HostAllocator::internalAllocation;
+		_callbacks.pfnInternalFree = &HostAllocator::internalFree;
+		_installed = this;
+	}
+
+	HostAllocator::~HostAllocator()
+	{
+		_installed = nullptr;
+	}
+
+	VkAllocationCallbacks* HostAllocator::getCallbacks()
+	{
+		return _installed != nullptr ? &_installed->_callbacks : nullptr;
+	}
+
+	std::array<HostAllocator::ScopeStatistics, HostAllocator::ScopeCount> HostAllocator::getStatistics() const
+	{
+		std::array<ScopeStatistics, ScopeCount> statistics = {};
+		for (std::size_t i = 0; i < ScopeCount; ++i)
+		{
+			const ScopeCounters& counters = _counters[i];
+			statistics[i].allocationCount = counters.allocationCount.load(std::memory_order_relaxed);
+			statistics[i].reallocationCount = counters.reallocationCount.load(std::memory_order_relaxed);
+			statistics[i].freeCount = counters.freeCount.load(std::memory_order_relaxed);
+			statistics[i].arenaAllocationCount = counters.arenaAllocationCount.load(std::memory_order_relaxed);
+			statistics[i].bytes = counters.bytes.load(std::memory_order_relaxed);
+			statistics[i].peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+			statistics[i].internalBytes = counters.internalBytes.load(std::memory_order_relaxed);
+		}
+		return statistics;
+	}
+
+	void HostAllocator::resetCounters()
+	{
+		for (ScopeCounters& counters : _counters)
+		{
+			counters.allocationCount.store(0, std::memory_order_relaxed);
+			counters.reallocationCount.store(0, std::memory_order_relaxed);
+			counters.freeCount.store(0, std::memory_order_relaxed);
+			counters.arenaAllocationCount.store(0, std::memory_order_relaxed);
+			counters.peakBytes.store(counters.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+	}
+
+	const char* HostAllocator::getScopeName(VkSystemAllocationScope scope)
+	{
+		switch (scope)
+		{
+		case VK_SYSTEM_ALLOCATION_SCOPE_COMMAND:
+			return "Command";
+		case VK_SYSTEM_ALLOCATION_SCOPE_OBJECT:
+			return "Object";
+		case VK_SYSTEM_ALLOCATION_SCOPE_CACHE:
+			return "Cache";
+		case VK_SYSTEM_ALLOCATION_SCOPE_DEVICE:
+			return "Device";
+		case VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE:
+			return "Instance";
+		default:
+			return "Unknown";
+		}
+	}
+
+	void* VKAPI_PTR HostAllocator::allocation(void* userData, std::size_t size, std::size_t alignment,
+			VkSystemAllocationScope scope)
+	{
+		auto* self = static_cast<HostAllocator*>(userData);
+		void* memory = self->allocate(size, alignment, scope);
+		if (memory != nullptr)
+			self->_counters[scope].allocationCount.fetch_add(1, std::memory_order_relaxed);
+		return memory;
+	}
+
+	void* VKAPI_PTR HostAllocator::reallocation(void* userData, void* original, std::size_t size,
+			std::size_t alignment, VkSystemAllocationScope scope)
+	{
+		auto* self = static_cast<HostAllocator*>(userData);
+		if (original == nullptr)
+			return allocation(userData, size, alignment, scope);
+		if (size == 0)
+		{
+			free(userData, original);
+			return nullptr;
+		}
+		// On failure the original allocation must be left untouched
+		void* memory = self->allocate(size, alignment, scope);
+		if (memory == nullptr)
+			return nullptr;
+		std::memcpy(memory, original, std::min(size, getHeader(original)->size));
+		self->release(original);
+		self->_counters[scope].reallocationCount.fetch_add(1, std::memory_order_relaxed);
+		return memory;
+	}
+
+	void VKAPI_PTR HostAllocator::free(void* userData, void* memory)
+	{
+		if (memory == nullptr)
+			return;
+		auto* self = static_cast<HostAllocator*>(userData);
+		self->_counters[getHeader(memory)->scope].freeCount.fetch_add(1, std::memory_order_relaxed);
+		self->release(memory);
+	}
+
+	void VKAPI_PTR HostAllocator::internalAllocation(void* userData, std::size_t size, VkInternalAllocationType,
+			VkSystemAllocationScope scope)
+	{
+		auto* self = static_cast<HostAllocator*>(userData);
+		self->_counters[scope].internalBytes.fetch_add(size, std::memory_order_relaxed);
+	}
+
+	void VKAPI_PTR HostAllocator::internalFree(void* userData, std::size_t size, VkInternalAllocationType,
+			VkSystemAllocationScope scope)
+	{
+		auto* self = static_cast<HostAllocator*>(userData);
+		self->_counters[scope].internalBytes.fetch_sub(size, std::memory_order_relaxed);
+	}
+
+	void* HostAllocator::allocate(std::size_t size, std::size_t alignment, VkSystemAllocationScope scope)
+	{
+		if (size == 0)
+			return nullptr;
+		alignment = std::max(alignment, MinAlignment);
+		ScopeCounters& counters = _counters[scope];
+		void* memory = nullptr;
+		Block* block = nullptr;
+		void* base = nullptr;
+		bool shortLived = scope == VK_SYSTEM_ALLOCATION_SCOPE_COMMAND || scope == VK_SYSTEM_ALLOCATION_SCOPE_OBJECT;
+		if (shortLived && size + alignment + sizeof(AllocationHeader) <= _blockSize / 4)
+		{
+			memory = threadArena.allocate(size, alignment, _blockSize);
+			if (memory != nullptr)
+			{
+				block = threadArena.block;
+				counters.arenaAllocationCount.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+		if (memory == nullptr)
+		{
+			base = std::malloc(size + alignment + sizeof(AllocationHeader));
+			if (base == nullptr)
+				return nullptr;
+			memory = reinterpret_cast<void*>(
+					alignUp(reinterpret_cast<std::uintptr_t>(base) + sizeof(AllocationHeader), alignment));
+		}
+		*getHeader(memory) = { block, base, size, scope };
+		addBytes(counters, size);
+		return memory;
+	}
+
+	void HostAllocator::release(void* memory)
+	{
+		AllocationHeader* header = getHeader(memory);
+		_counters[header->scope].bytes.fetch_sub(header->size, std::memory_order_relaxed);
+		if (header->block != nullptr)
+			releaseBlock(header->block);
+		else
+			std::free(header->base);
+	}
+
+	void HostAllocator::addBytes(ScopeCounters& counters, std::size_t size)
+	{
+		std::uint64_t bytes = counters.bytes.fetch_add(size, std::memory_order_relaxed) + size;
+		std::uint64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+		while (bytes > peak && !counters.peakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed))
+		{
+		}
+	}
+} // Concerto::Graphics::Wrapper
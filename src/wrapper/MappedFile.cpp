@@ -0,0 +1,132 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/MappedFile.hpp"
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Concerto::Graphics::Wrapper
+{
+	MappedFile::MappedFile(MappedFile&& other) noexcept : _data(std::exchange(other._data, nullptr)),
+														  _size(std::exchange(other._size, 0))
+#ifdef _WIN32
+			, _file(std::exchange(other._file, nullptr)), _mapping(std::exchange(other._mapping, nullptr))
+#endif
+	{
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			close();
+			_data = std::exchange(other._data, nullptr);
+			_size = std::exchange(other._size, 0);
+#ifdef _WIN32
+			_file = std::exchange(other._file, nullptr);
+			_mapping = std::exchange(other._mapping, nullptr);
+#endif
+		}
+		return *this;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+	bool MappedFile::open(const std::string& path)
+	{
+		close();
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+				OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+		{
+			CloseHandle(file);
+			return false;
+		}
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data == nullptr)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+		_file = file;
+		_mapping = mapping;
+		_data = static_cast<const std::byte*>(data);
+		_size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+		struct stat fileStat{};
+		if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+		{
+			::close(fd);
+			return false;
+		}
+		void* data = mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		// the mapping keeps its own reference on the file
+		::close(fd);
+		if (data == MAP_FAILED)
+			return false;
+		_data = static_cast<const std::byte*>(data);
+		_size = static_cast<std::size_t>(fileStat.st_size);
+#endif
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+		if (_data == nullptr)
+			return;
+#ifdef _WIN32
+		UnmapViewOfFile(_data);
+		CloseHandle(_mapping);
+		CloseHandle(_file);
+		_mapping = nullptr;
+		_file = nullptr;
+#else
+		munmap(const_cast<std::byte*>(_data), _size);
+#endif
+		_data = nullptr;
+		_size = 0;
+	}
+
+	bool MappedFile::isOpen() const
+	{
+		return _data != nullptr;
+	}
+
+	const std::byte* MappedFile::data() const
+	{
+		return _data;
+	}
+
+	std::size_t MappedFile::size() const
+	{
+		return _size;
+	}
+}
\ No newline at end of file
@@ -6,121 +6,500 @@
 
 #include "wrapper/Mesh.hpp"
 
-#define TINYOBJLOADER_IMPLEMENTATION
-
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
-#include <stdexcept>a
-#include "tiny_obj_loader.h"
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include "glm/gtx/transform.hpp"
+#include "wrapper/GltfParser.hpp"
+#include "wrapper/ObjParser.hpp"
 namespace Concerto::Graphics::Wrapper
 {
-	Mesh::Mesh(Vertices vertices, Allocator& allocator, std::size_t allocSize, VkBufferUsageFlags usage,
-			VmaMemoryUsage memoryUsage) : _isLoaded(!vertices.empty()),
-										  _vertices(std::move(vertices)),
-										  _vertexBuffer(allocator, allocSize, usage, memoryUsage)
+	namespace
+	{
+		Indices makeSequentialIndices(std::size_t count)
+		{
+			Indices indices(count);
+			std::iota(indices.begin(), indices.end(), 0u);
+			return indices;
+		}
+
+		glm::vec3 getQuantizationExtent(const BoundingBox& box)
+		{
+			// A flat axis would divide by zero, any non null extent quantizes it to 0
+			glm::vec3 extent = box.max - box.min;
+			for (int i = 0; i < 3; ++i)
+				if (extent[i] <= 0.f)
+					extent[i] = 1.f;
+			return extent;
+		}
+	}
+
+	MeshData::MeshData(Vertices vertices) : _vertices(std::move(vertices)),
+											_indices(makeSequentialIndices(_vertices.size())),
+											_vertexFormat(VertexFormat::Standard),
+											_vertexCount(_vertices.size()),
+											_indexCount(_indices.size()),
+											_boundingBox(computeBoundingBox(_vertices)),
+											_boundingSphere(computeBoundingSphere(_vertices)),
+											_optimizationStatistics(),
+											_isLoaded(!_vertices.empty())
 	{
 		if (!_isLoaded)
 			throw std::runtime_error("Empty vertices");
-		void* data;
-		vmaMapMemory(allocator._allocator, _vertexBuffer._allocation, &data);
+		_lods.push_back({ 0, static_cast<std::uint32_t>(_indexCount), 0.f });
+	}
 
-		std::memcpy(data, _vertices.data(), allocSize);
+	MeshData::MeshData(const std::string& file, const MeshLoadOptions& options) : _vertexFormat(options.vertexFormat),
+																				   _vertexCount(0),
+																				   _indexCount(0),
+																				   _boundingBox(),
+																				   _boundingSphere(),
+																				   _optimizationStatistics(),
+																				   _isLoaded(load(file, options))
+	{
+		if (!_isLoaded)
+			throw std::runtime_error("Empty vertices");
+	}
 
-		vmaUnmapMemory(allocator._allocator, _vertexBuffer._allocation);
+	Mesh::Mesh(Vertices vertices, Allocator& allocator, std::size_t allocSize, VkBufferUsageFlags usage,
+			VmaMemoryUsage memoryUsage) : MeshData(std::move(vertices)),
+										  _vertexBuffer(std::in_place, allocator, allocSize, usage, memoryUsage,
+												  VMA_ALLOCATION_CREATE_MAPPED_BIT),
+										  _indexBuffer(std::in_place, allocator, _indexCount * sizeof(std::uint32_t),
+												  VK_BUFFER_USAGE_INDEX_BUFFER_BIT, memoryUsage,
+												  VMA_ALLOCATION_CREATE_MAPPED_BIT),
+										  _arena(nullptr),
+										  _vertexRange(),
+										  _indexRange()
+	{
+		upload();
 	}
 
 	Mesh::Mesh(const std::string& file, Allocator& allocator, VkBufferUsageFlags usage,
-			VmaMemoryUsage memoryUsage) : _isLoaded(
-			loadFromObj(file, std::filesystem::path(file).parent_path().string())),
-										  _vertexBuffer(allocator, _vertices.size() * sizeof(Vertex), usage,
-												  memoryUsage)
+			VmaMemoryUsage memoryUsage, const MeshLoadOptions& options) : Mesh(MeshData(file, options), allocator,
+			usage, memoryUsage)
 	{
-		if (!_isLoaded)
-			throw std::runtime_error("Empty vertices");
-		void* data;
-		vmaMapMemory(allocator._allocator, _vertexBuffer._allocation, &data);
+	}
 
-		std::memcpy(data, _vertices.data(), _vertices.size() * sizeof(Vertex));
+	Mesh::Mesh(MeshData data, Allocator& allocator, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage) :
+			MeshData(std::move(data)),
+			_vertexBuffer(std::in_place, allocator, _vertexCount * getVertexStride(), usage, memoryUsage,
+					VMA_ALLOCATION_CREATE_MAPPED_BIT),
+			_indexBuffer(std::in_place, allocator, _indexCount * sizeof(std::uint32_t),
+					VK_BUFFER_USAGE_INDEX_BUFFER_BIT, memoryUsage, VMA_ALLOCATION_CREATE_MAPPED_BIT),
+			_arena(nullptr),
+			_vertexRange(),
+			_indexRange()
+	{
+		upload();
+	}
 
-		vmaUnmapMemory(allocator._allocator, _vertexBuffer._allocation);
+	Mesh::Mesh(MeshData data, UploadContext& uploadContext, VkBufferUsageFlags usage) : MeshData(std::move(data)),
+			_arena(nullptr),
+			_vertexRange(),
+			_indexRange()
+	{
+		Allocator& allocator = uploadContext.getAllocator();
+		// Meshes share the blocks of the pool instead of creating two buffers and allocations each
+		if ((usage & ~allocator.getBufferPool(BufferUsage::Geometry).getUsage()) == 0)
+		{
+			_pooledVertexBuffer = allocator.allocateBuffer(BufferUsage::Geometry, _vertexCount * getVertexStride());
+			_pooledIndexBuffer = allocator.allocateBuffer(BufferUsage::Geometry, _indexCount * sizeof(std::uint32_t));
+		}
+		else
+		{
+			_vertexBuffer.emplace(allocator, _vertexCount * getVertexStride(), usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+					VMA_MEMORY_USAGE_GPU_ONLY);
+			_indexBuffer.emplace(allocator, _indexCount * sizeof(std::uint32_t),
+					VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+		}
+		upload(uploadContext);
 	}
 
-	bool Mesh::loadFromObj(const std::string& fileName, const std::string& materialPath)
+	Mesh::Mesh(const std::string& file, UploadContext& uploadContext, VkBufferUsageFlags usage,
+			const MeshLoadOptions& options) : Mesh(MeshData(file, options), uploadContext, usage)
 	{
-		std::string err;
-		tinyobj::ObjReaderConfig readerConfig;
-		tinyobj::ObjReader reader;
+	}
 
-		readerConfig.mtl_search_path = materialPath;
-		if (!reader.ParseFromFile(fileName, readerConfig))
+	Mesh::Mesh(MeshData data, GeometryArena& arena, UploadContext& uploadContext) : MeshData(std::move(data)),
+																					  _arena(&arena),
+																					  _vertexRange(),
+																					  _indexRange()
+	{
+		if (_vertexFormat != arena.getVertexFormat())
+			throw std::runtime_error("Mesh: vertex format does not match the geometry arena");
+		std::optional<GeometryArena::Range> vertexRange = arena.allocateVertices(static_cast<std::uint32_t>(_vertexCount));
+		if (!vertexRange)
+			throw std::runtime_error("GeometryArena: out of vertex space");
+		std::optional<GeometryArena::Range> indexRange = arena.allocateIndices(static_cast<std::uint32_t>(_indexCount));
+		if (!indexRange)
 		{
-			if (!reader.Error().empty())
-			{
-				std::cerr << "TinyObjReader error: " << reader.Error() << std::endl;
+			arena.freeVertices(*vertexRange);
+			throw std::runtime_error("GeometryArena: out of index space");
+		}
+		_vertexRange = *vertexRange;
+		_indexRange = *indexRange;
+		arena.uploadVertices(uploadContext, _vertexRange, getUploadVertexData());
+		std::span<const std::byte> indices = getUploadIndexData();
+		arena.uploadIndices(uploadContext, _indexRange, { reinterpret_cast<const std::uint32_t*>(indices.data()),
+														  _indexCount });
+		_cache.close();
+	}
+
+	Mesh::~Mesh()
+	{
+		if (!_arena)
+			return;
+		_arena->freeVertices(_vertexRange);
+		_arena->freeIndices(_indexRange);
+	}
+
+	void Mesh::bind(CommandBuffer& commandBuffer) const
+	{
+		if (_arena)
+		{
+			_arena->bind(commandBuffer);
+			return;
+		}
+		if (_vertexFormat == VertexFormat::Split)
+		{
+			const VkBuffer buffers[] = { getVertexBuffer(), getVertexBuffer() };
+			const VkDeviceSize offsets[] = { getVertexBufferOffset(), getVertexBufferOffset() + getAttributeOffset() };
+			commandBuffer.bindVertexBuffers(0, buffers, offsets);
+		}
+		else
+			bindVertexBuffer(commandBuffer);
+		bindIndexBuffer(commandBuffer);
+	}
+
+	void Mesh::bindPositions(CommandBuffer& commandBuffer) const
+	{
+		if (_arena)
+		{
+			_arena->bindPositions(commandBuffer);
+			return;
+		}
+		//the positions stream starts at the beginning of the vertex buffer
+		bindVertexBuffer(commandBuffer);
+		bindIndexBuffer(commandBuffer);
+	}
+
+	const void* Mesh::getGeometryBinding() const
+	{
+		if (_arena)
+			return _arena;
+		return this;
+	}
+
+	std::int32_t Mesh::getVertexOffset() const
+	{
+		return _arena ? static_cast<std::int32_t>(_vertexRange.offset) : 0;
+	}
+
+	std::uint32_t Mesh::getFirstIndex() const
+	{
+		return _arena ? _indexRange.offset : 0;
+	}
+
+	bool MeshData::load(const std::string& file, const MeshLoadOptions& options)
+	{
+		const bool isGlb = std::filesystem::path(file).extension() == ".glb";
+		if (isGlb && !options.optimize && !options.buildMeshlets && options.lodCount <= 1 &&
+			_vertexFormat != VertexFormat::Packed)
+		{
+			// Nothing to compute at import time, the GLB is read straight into the upload layout without a cache
+			if (!loadFromGlb(file, false))
 				return false;
-			}
+			_lods.push_back({ 0, static_cast<std::uint32_t>(_indexCount), 0.f });
+			return _vertexCount != 0;
 		}
-		if (!reader.Warning().empty())
+
+		std::uint32_t cacheFlags = options.optimize ? MeshCache::FlagOptimized : 0;
+		if (_vertexFormat == VertexFormat::Packed)
+			cacheFlags |= MeshCache::FlagPackedVertices;
+		else if (_vertexFormat == VertexFormat::Split)
+			cacheFlags |= MeshCache::FlagSplitVertices;
+		if (options.buildMeshlets)
+			cacheFlags |= MeshCache::FlagMeshlets;
+		if (options.lodCount > 1)
+			cacheFlags |= std::min(options.lodCount, 0xFFu) << MeshCache::LodCountShift;
+		if (_cache.open(file, cacheFlags))
 		{
-			std::cout << "TinyObjReader: " << reader.Warning();
+			_vertexCount = _cache.getVertexCount();
+			_indexCount = _cache.getIndices().size();
+			_boundingBox = _cache.getMetadata().boundingBox;
+			_boundingSphere = _cache.getMetadata().boundingSphere;
+			_optimizationStatistics = _cache.getMetadata().optimizationStatistics;
+			_meshlets.assign(_cache.getMeshlets().begin(), _cache.getMeshlets().end());
+			_lods.assign(_cache.getLods().begin(), _cache.getLods().end());
+			return _vertexCount != 0;
 		}
+		if (isGlb ? !loadFromGlb(file, true) : !loadFromObj(file, std::filesystem::path(file).parent_path().string()))
+			return false;
+		if (options.optimize)
+			optimize();
+		if (options.buildMeshlets)
+			buildMeshlets();
+		buildLods(std::min(options.lodCount, 0xFFu), options.optimize);
+		_vertexCount = _vertices.size();
+		_indexCount = _indices.size();
+		_boundingBox = computeBoundingBox(_vertices);
+		_boundingSphere = computeBoundingSphere(_vertices);
+		encodeVertices();
+		MeshCache::Metadata metadata{ cacheFlags, _boundingBox, _boundingSphere, _optimizationStatistics };
+		MeshCache::Blobs blobs{ getVertexData(), std::as_bytes(std::span(_indices)),
+								std::as_bytes(std::span(_meshlets)), std::as_bytes(std::span(_lods)) };
+		if (!MeshCache::write(file, blobs, _vertexCount, metadata))
+			std::cerr << "Mesh: unable to cache " << file << std::endl;
+		return true;
+	}
+
+	std::span<const std::byte> Mesh::getUploadVertexData() const
+	{
+		if (_cache.isOpen())
+			return _cache.getVertexData().first(_vertexCount * getVertexStride());
+		return getVertexData().first(_vertexCount * getVertexStride());
+	}
 
-		if (!err.empty())
+	std::span<const std::byte> Mesh::getUploadIndexData() const
+	{
+		if (_cache.isOpen())
+			return std::as_bytes(_cache.getIndices().first(_indexCount));
+		return std::as_bytes(std::span(_indices).first(_indexCount));
+	}
+
+	void Mesh::upload()
+	{
+		std::span<const std::byte> vertices = getUploadVertexData();
+		std::span<const std::byte> indices = getUploadIndexData();
+		std::memcpy(_vertexBuffer->getMappedData().data(), vertices.data(), vertices.size());
+		_vertexBuffer->flush(0, vertices.size());
+		std::memcpy(_indexBuffer->getMappedData().data(), indices.data(), indices.size());
+		_indexBuffer->flush(0, indices.size());
+		_cache.close();
+	}
+
+	void Mesh::upload(UploadContext& uploadContext)
+	{
+		if (_pooledVertexBuffer.isValid())
 		{
-			std::cerr << err << std::endl;
+			uploadContext.upload(_pooledVertexBuffer, 0, getUploadVertexData());
+			uploadContext.upload(_pooledIndexBuffer, 0, getUploadIndexData());
 		}
+		else
+		{
+			uploadContext.upload(*_vertexBuffer, 0, getUploadVertexData());
+			uploadContext.upload(*_indexBuffer, 0, getUploadIndexData());
+		}
+		_cache.close();
+	}
+
+	VkBuffer Mesh::getVertexBuffer() const
+	{
+		return _pooledVertexBuffer.isValid() ? _pooledVertexBuffer.getBuffer() : _vertexBuffer->_buffer;
+	}
+
+	VkDeviceSize Mesh::getVertexBufferOffset() const
+	{
+		return _pooledVertexBuffer.getOffset();
+	}
+
+	void Mesh::bindVertexBuffer(CommandBuffer& commandBuffer) const
+	{
+		const VkBuffer buffer = getVertexBuffer();
+		const VkDeviceSize offset = getVertexBufferOffset();
+		commandBuffer.bindVertexBuffers(0, { &buffer, 1 }, { &offset, 1 });
+	}
 
-		auto& attrib = reader.GetAttrib();
-		auto& shapes = reader.GetShapes();
-		auto& materials = reader.GetMaterials();
+	void Mesh::bindIndexBuffer(CommandBuffer& commandBuffer) const
+	{
+		if (_pooledIndexBuffer.isValid())
+			commandBuffer.bindIndexBuffer(_pooledIndexBuffer.getBuffer(), _pooledIndexBuffer.getOffset());
+		else
+			commandBuffer.bindIndexBuffer(*_indexBuffer);
+	}
 
-		for (auto& shape: shapes)
+	bool MeshData::loadFromObj(const std::string& fileName, const std::string& materialPath)
+	{
+		ObjParser parser;
+		switch (parser.parse(fileName, _vertices))
+		{
+		case ObjParser::Result::Success:
+			std::cout << "Mesh " << fileName << ": parsed " << parser.getParsedBytes() / (1024.0 * 1024.0) << " MB in "
+					  << parser.getParseTime() * 1000.0 << " ms with " << parser.getThreadCount() << " threads ("
+					  << parser.getThroughput() << " MB/s)" << std::endl;
+			break;
+		case ObjParser::Result::Unsupported:
+			std::cout << "Mesh " << fileName << ": polygons with more than 4 vertices, falling back to tinyobj"
+					  << std::endl;
+			if (!loadFromObjWithTinyObj(fileName, materialPath))
+				return false;
+			break;
+		case ObjParser::Result::Error:
+			return false;
+		}
+		std::size_t faceVertexCount = _vertices.size();
+		deduplicateVertices();
+		std::cout << "Mesh " << fileName << ": " << faceVertexCount << " vertices -> " << _vertices.size()
+				  << " unique vertices, " << _indices.size() << " indices" << std::endl;
+		return !_vertices.empty();
+	}
+
+	bool MeshData::loadFromGlb(const std::string& fileName, bool keepVertices)
+	{
+		GltfParser parser;
+		if (parser.parse(fileName) != GltfParser::Result::Success)
+			return false;
+		std::cout << "Mesh " << fileName << ": parsed " << parser.getParsedBytes() / (1024.0 * 1024.0) << " MB in "
+				  << parser.getParseTime() * 1000.0 << " ms, " << parser.getPrimitiveCount() << " primitives, "
+				  << parser.getVertexCount() << " vertices, " << parser.getIndexCount() << " indices" << std::endl;
+		_vertexCount = parser.getVertexCount();
+		_indexCount = parser.getIndexCount();
+		_indices.resize(_indexCount);
+		parser.readIndices(_indices);
+		_boundingBox = parser.getBoundingBox();
+		if (keepVertices || _vertexFormat == VertexFormat::Standard)
 		{
-			// Loop over faces(polygon)
-			std::size_t index_offset = 0;
-			for (std::size_t f = 0; f < shape.mesh.num_face_vertices.size(); f++)
+			_vertices.resize(_vertexCount);
+			parser.readVertices(_vertices);
+			_boundingSphere = computeBoundingSphere(_vertices);
+			return !_vertices.empty();
+		}
+		// VertexFormat::Split, both streams are filled in place
+		_vertexData.resize(_vertexCount * (sizeof(glm::vec3) + sizeof(VertexAttributes)));
+		std::span positions(reinterpret_cast<glm::vec3*>(_vertexData.data()), _vertexCount);
+		std::span attributes(reinterpret_cast<VertexAttributes*>(_vertexData.data() + _vertexCount * sizeof(glm::vec3)),
+				_vertexCount);
+		parser.readVertices(positions, attributes);
+		_boundingSphere = computeBoundingSphere(std::span<const glm::vec3>(positions));
+		return _vertexCount != 0;
+	}
+
+	bool MeshData::loadFromObjWithTinyObj(const std::string& fileName, const std::string& materialPath)
+	{
+		return ObjParser::parseWithTinyObj(fileName, materialPath, _vertices);
+	}
+
+	void MeshData::deduplicateVertices()
+	{
+		std::unordered_map<Vertex, std::uint32_t> uniqueVertices;
+		uniqueVertices.reserve(_vertices.size());
+		Vertices vertices;
+		vertices.reserve(_vertices.size());
+		_indices.clear();
+		_indices.reserve(_vertices.size());
+
+		for (const Vertex& vertex: _vertices)
+		{
+			auto [it, inserted] = uniqueVertices.try_emplace(vertex, static_cast<std::uint32_t>(vertices.size()));
+			if (inserted)
+				vertices.push_back(vertex);
+			_indices.push_back(it->second);
+		}
+		vertices.shrink_to_fit();
+		_vertices = std::move(vertices);
+	}
+
+	void MeshData::optimize()
+	{
+		_optimizationStatistics.before = analyzeVertexCache(_indices, _vertices.size());
+		_indices = optimizeVertexCache(_indices, _vertices.size());
+		_indices = optimizeOverdraw(_indices, _vertices);
+		optimizeVertexFetch(_vertices, _indices);
+		_optimizationStatistics.after = analyzeVertexCache(_indices, _vertices.size());
+		std::cout << "Mesh: ACMR " << _optimizationStatistics.before.acmr << " -> " << _optimizationStatistics.after.acmr
+				  << ", ATVR " << _optimizationStatistics.before.atvr << " -> " << _optimizationStatistics.after.atvr
+				  << std::endl;
+	}
+
+	void MeshData::buildMeshlets()
+	{
+		_meshlets = Wrapper::buildMeshlets(_indices, _vertices);
+		std::cout << "Mesh: " << _indices.size() / 3 << " triangles -> " << _meshlets.size() << " meshlets"
+				  << std::endl;
+	}
+
+	void MeshData::buildLods(std::uint32_t lodCount, bool optimize)
+	{
+		_lods.clear();
+		_lods.push_back({ 0, static_cast<std::uint32_t>(_indices.size()), 0.f });
+		Indices lod(_indices.begin(), _indices.end());
+		for (std::uint32_t level = 1; level < lodCount; ++level)
+		{
+			float error = 0.f;
+			Indices simplified = simplifyMesh(lod, _vertices, lod.size() / 6 * 3, std::numeric_limits<float>::max(),
+					&error);
+			// Locked borders and seams or flips stop the simplification, a level that barely shrinks is not worth drawing
+			if (simplified.empty() || simplified.size() > lod.size() * 9 / 10)
+				break;
+			if (optimize)
+				simplified = optimizeVertexCache(simplified, _vertices.size());
+			_lods.push_back({ static_cast<std::uint32_t>(_indices.size()), static_cast<std::uint32_t>(simplified.size()),
+							  _lods.back().error + error });
+			_indices.insert(_indices.end(), simplified.begin(), simplified.end());
+			std::cout << "Mesh: LOD " << level << " " << simplified.size() / 3 << " triangles, error " << error
+					  << std::endl;
+			lod = std::move(simplified);
+		}
+	}
+
+	void MeshData::encodeVertices()
+	{
+		_vertexData.clear();
+		if (_vertexFormat == VertexFormat::Packed)
+		{
+			const glm::vec3 extent = getQuantizationExtent(_boundingBox);
+			_vertexData.resize(_vertices.size() * sizeof(PackedVertex));
+			auto* packed = reinterpret_cast<PackedVertex*>(_vertexData.data());
+			for (std::size_t i = 0; i < _vertices.size(); ++i)
+				packed[i] = PackedVertex::pack(_vertices[i], _boundingBox.min, extent);
+			std::cout << "Mesh: packed " << _vertices.size() * sizeof(Vertex) << " bytes of vertices into "
+					  << _vertexData.size() << " bytes" << std::endl;
+		}
+		else if (_vertexFormat == VertexFormat::Split)
+		{
+			_vertexData.resize(_vertices.size() * (sizeof(glm::vec3) + sizeof(VertexAttributes)));
+			auto* positions = reinterpret_cast<glm::vec3*>(_vertexData.data());
+			auto* attributes = reinterpret_cast<VertexAttributes*>(_vertexData.data() + _vertices.size() * sizeof(glm::vec3));
+			for (std::size_t i = 0; i < _vertices.size(); ++i)
 			{
-				//hardcode loading to triangles
-				int fv = 3;
-				// Loop over vertices in the face.
-				for (std::size_t v = 0; v < fv; v++)
-				{
-					// access to vertex
-					tinyobj::index_t idx = shape.mesh.indices[index_offset + v];
-
-					//vertex position
-					tinyobj::real_t vx = attrib.vertices[3 * idx.vertex_index + 0];
-					tinyobj::real_t vy = attrib.vertices[3 * idx.vertex_index + 1];
-					tinyobj::real_t vz = attrib.vertices[3 * idx.vertex_index + 2];
-					//vertex normal
-					tinyobj::real_t nx = attrib.normals[3 * idx.normal_index + 0];
-					tinyobj::real_t ny = attrib.normals[3 * idx.normal_index + 1];
-					tinyobj::real_t nz = attrib.normals[3 * idx.normal_index + 2];
-
-					//copy it into our vertex
-					Vertex new_vert{};
-					new_vert.position.x = vx;
-					new_vert.position.y = vy;
-					new_vert.position.z = vz;
-
-					new_vert.normal.x = nx;
-					new_vert.normal.y = ny;
-					new_vert.normal.z = nz;
-
-					//we are setting the vertex color as the vertex normal. This is just for display purposes
-					new_vert.color = new_vert.normal;
-					//vertex uv
-					tinyobj::real_t ux = attrib.texcoords[2 * idx.texcoord_index + 0];
-					tinyobj::real_t uy = attrib.texcoords[2 * idx.texcoord_index + 1];
-
-					new_vert.uv.x = ux;
-					new_vert.uv.y = 1 - uy;
-					_vertices.push_back(new_vert);
-				}
-				index_offset += fv;
+				positions[i] = _vertices[i].position;
+				attributes[i] = { _vertices[i].normal, _vertices[i].color, _vertices[i].uv };
 			}
 		}
-		return true;
 	}
 
+	std::span<const std::byte> MeshData::getVertexData() const
+	{
+		if (_vertexFormat == VertexFormat::Standard)
+			return std::as_bytes(std::span(_vertices));
+		return _vertexData;
+	}
+
+	glm::mat4 MeshData::getPositionTransform() const
+	{
+		if (_vertexFormat != VertexFormat::Packed)
+			return glm::mat4(1.f);
+		return glm::translate(glm::mat4(1.f), _boundingBox.min) *
+			   glm::scale(glm::mat4(1.f), getQuantizationExtent(_boundingBox));
+	}
+
+	std::size_t MeshData::getVertexStride() const
+	{
+		return Wrapper::getVertexStride(_vertexFormat);
+	}
+
+	VkDeviceSize MeshData::getAttributeOffset() const
+	{
+		return _vertexFormat == VertexFormat::Split ? _vertexCount * sizeof(glm::vec3) : 0;
+	}
 
+	std::size_t MeshData::getUploadSize() const
+	{
+		return _vertexCount * getVertexStride() + _indexCount * sizeof(std::uint32_t);
+	}
 } // Concerto::Graphics::Wrapper
\ No newline at end of file
@@ -0,0 +1,278 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/MeshCache.hpp"
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace Concerto::Graphics::Wrapper
+{
+	namespace
+	{
+		constexpr std::uint64_t FnvOffsetBasis = 14695981039346656037ull;
+		constexpr std::uint64_t FnvPrime = 1099511628211ull;
+		constexpr std::uint64_t BlobAlignment = 16;
+
+		std::uint64_t hashBytes(const std::byte* data, std::size_t size)
+		{
+			std::uint64_t hash = FnvOffsetBasis;
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				hash ^= static_cast<std::uint64_t>(data[i]);
+				hash *= FnvPrime;
+			}
+			return hash;
+		}
+
+		std::uint64_t alignBlobOffset(std::uint64_t offset)
+		{
+			return (offset + BlobAlignment - 1) & ~(BlobAlignment - 1);
+		}
+
+		struct SourceInfo
+		{
+			std::uint64_t pathHash;
+			std::int64_t time;
+			std::uint64_t size;
+		};
+
+		bool getSourceInfo(const std::string& sourcePath, SourceInfo& info)
+		{
+			std::error_code error;
+			const std::string path = std::filesystem::absolute(sourcePath, error).generic_string();
+			if (error)
+				return false;
+			info.pathHash = hashBytes(reinterpret_cast<const std::byte*>(path.data()), path.size());
+			info.size = std::filesystem::file_size(sourcePath, error);
+			if (error)
+				return false;
+			auto time = std::filesystem::last_write_time(sourcePath, error);
+			if (error)
+				return false;
+			info.time = static_cast<std::int64_t>(time.time_since_epoch().count());
+			return true;
+		}
+
+		// Written so that a corrupted offset or count can not wrap around
+		bool isRangeInside(std::uint64_t first, std::uint64_t count, std::uint64_t size)
+		{
+			return first <= size && count <= size - first;
+		}
+
+		bool writeSourceTime(const std::string& cachePath, std::int64_t time)
+		{
+			std::fstream file(cachePath, std::ios::binary | std::ios::in | std::ios::out);
+			if (!file.is_open())
+				return false;
+			file.seekp(offsetof(MeshCache::Header, sourceTime));
+			file.write(reinterpret_cast<const char*>(&time), sizeof(time));
+			file.flush();
+			return file.good();
+		}
+
+		bool hashSourceContent(const std::string& sourcePath, std::uint64_t& hash)
+		{
+			MappedFile source;
+			if (!source.open(sourcePath))
+				return false;
+			hash = hashBytes(source.data(), source.size());
+			return true;
+		}
+	}
+
+	std::string MeshCache::getCachePath(const std::string& sourcePath)
+	{
+		return sourcePath + ".meshcache";
+	}
+
+	bool MeshCache::open(const std::string& sourcePath, std::uint32_t flags)
+	{
+		close();
+		SourceInfo source{};
+		if (!getSourceInfo(sourcePath, source))
+			return false;
+		const std::string cachePath = getCachePath(sourcePath);
+		if (!map(cachePath, flags, source.pathHash, source.size))
+			return false;
+		if (_header.sourceTime != source.time)
+		{
+			// The source has been touched, only rebuild if its content really changed
+			std::uint64_t contentHash = 0;
+			if (!hashSourceContent(sourcePath, contentHash) || contentHash != _header.contentHash)
+			{
+				close();
+				return false;
+			}
+			// The header is patched once the file is unmapped, then the cache is mapped again
+			close();
+			if (!writeSourceTime(cachePath, source.time))
+				std::cerr << "MeshCache: unable to update " << cachePath << ", the source will be hashed again"
+						  << std::endl;
+			return map(cachePath, flags, source.pathHash, source.size);
+		}
+		return true;
+	}
+
+	bool MeshCache::map(const std::string& cachePath, std::uint32_t flags, std::uint64_t pathHash,
+			std::uint64_t sourceSize)
+	{
+		if (!_file.open(cachePath))
+			return false;
+		if (_file.size() < sizeof(Header))
+		{
+			close();
+			return false;
+		}
+		std::memcpy(&_header, _file.data(), sizeof(Header));
+		const std::uint32_t vertexStride = getVertexStride(flags);
+		bool compatible = _header.magic == Magic && _header.version == Version &&
+						  _header.pathHash == pathHash && _header.sourceSize == sourceSize &&
+						  _header.vertexStride == vertexStride && _header.metadata.flags == flags &&
+						  _header.blobs[BlobVertices].size % vertexStride == 0 &&
+						  _header.blobs[BlobVertices].size / vertexStride == _header.vertexCount &&
+						  _header.blobs[BlobIndices].size % sizeof(std::uint32_t) == 0 &&
+						  _header.blobs[BlobMeshlets].size % sizeof(Meshlet) == 0 &&
+						  _header.blobs[BlobLods].size % sizeof(MeshLod) == 0;
+		for (const BlobRange& blob: _header.blobs)
+			compatible = compatible && isRangeInside(blob.offset, blob.size, _file.size());
+		// The ranges are used to draw straight from the index buffer, a single one out of it invalidates the cache
+		if (compatible)
+		{
+			const std::size_t indexCount = getIndices().size();
+			compatible = !getLods().empty();
+			for (const MeshLod& lod: getLods())
+				compatible = compatible && isRangeInside(lod.firstIndex, lod.indexCount, indexCount);
+			for (const Meshlet& meshlet: getMeshlets())
+				compatible = compatible &&
+							 isRangeInside(meshlet.firstIndex, std::uint64_t{ meshlet.triangleCount } * 3, indexCount);
+		}
+		if (!compatible)
+		{
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	void MeshCache::close()
+	{
+		_file.close();
+		_header = {};
+	}
+
+	bool MeshCache::isOpen() const
+	{
+		return _file.isOpen();
+	}
+
+	std::span<const std::byte> MeshCache::getBlob(Blob blob) const
+	{
+		if (!isOpen())
+			return {};
+		return { _file.data() + _header.blobs[blob].offset, _header.blobs[blob].size };
+	}
+
+	std::span<const std::byte> MeshCache::getVertexData() const
+	{
+		return getBlob(BlobVertices);
+	}
+
+	std::size_t MeshCache::getVertexCount() const
+	{
+		return _header.vertexCount;
+	}
+
+	std::span<const std::uint32_t> MeshCache::getIndices() const
+	{
+		std::span<const std::byte> blob = getBlob(BlobIndices);
+		return { reinterpret_cast<const std::uint32_t*>(blob.data()), blob.size() / sizeof(std::uint32_t) };
+	}
+
+	std::span<const Meshlet> MeshCache::getMeshlets() const
+	{
+		std::span<const std::byte> blob = getBlob(BlobMeshlets);
+		return { reinterpret_cast<const Meshlet*>(blob.data()), blob.size() / sizeof(Meshlet) };
+	}
+
+	std::span<const MeshLod> MeshCache::getLods() const
+	{
+		std::span<const std::byte> blob = getBlob(BlobLods);
+		return { reinterpret_cast<const MeshLod*>(blob.data()), blob.size() / sizeof(MeshLod) };
+	}
+
+	const MeshCache::Metadata& MeshCache::getMetadata() const
+	{
+		return _header.metadata;
+	}
+
+	std::uint32_t MeshCache::getVertexStride(std::uint32_t flags)
+	{
+		if (flags & FlagPackedVertices)
+			return sizeof(PackedVertex);
+		if (flags & FlagSplitVertices)
+			return sizeof(glm::vec3) + sizeof(VertexAttributes);
+		return sizeof(Vertex);
+	}
+
+	bool MeshCache::write(const std::string& sourcePath, const Blobs& blobs, std::size_t vertexCount,
+			const Metadata& metadata)
+	{
+		if (blobs[BlobVertices].size() != vertexCount * getVertexStride(metadata.flags))
+			return false;
+		SourceInfo source{};
+		if (!getSourceInfo(sourcePath, source))
+			return false;
+		Header header{};
+		header.magic = Magic;
+		header.version = Version;
+		header.pathHash = source.pathHash;
+		header.sourceTime = source.time;
+		header.sourceSize = source.size;
+		if (!hashSourceContent(sourcePath, header.contentHash))
+			return false;
+		header.vertexStride = getVertexStride(metadata.flags);
+		header.vertexCount = vertexCount;
+		std::uint64_t offset = sizeof(Header);
+		for (std::uint32_t blob = 0; blob < BlobCount; ++blob)
+		{
+			offset = alignBlobOffset(offset);
+			header.blobs[blob] = { offset, blobs[blob].size() };
+			offset += blobs[blob].size();
+		}
+		header.metadata = metadata;
+
+		const std::string cachePath = getCachePath(sourcePath);
+		const std::string tmpPath = cachePath + ".tmp";
+		{
+			std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+			if (!file.is_open())
+				return false;
+			const char padding[BlobAlignment] = {};
+			file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+			std::uint64_t written = sizeof(Header);
+			for (std::uint32_t blob = 0; blob < BlobCount; ++blob)
+			{
+				file.write(padding, static_cast<std::streamsize>(header.blobs[blob].offset - written));
+				file.write(reinterpret_cast<const char*>(blobs[blob].data()),
+						static_cast<std::streamsize>(blobs[blob].size()));
+				written = header.blobs[blob].offset + header.blobs[blob].size;
+			}
+			if (!file.good())
+				return false;
+		}
+		// Written aside then renamed so a crash never leaves a truncated cache behind
+		std::error_code error;
+		std::filesystem::rename(tmpPath, cachePath, error);
+		if (error)
+		{
+			std::cerr << "MeshCache: unable to write " << cachePath << ": " << error.message() << std::endl;
+			std::filesystem::remove(tmpPath, error);
+			return false;
+		}
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/MeshLoader.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+
+namespace Concerto::Graphics::Wrapper
+{
+	MeshLoader::MeshLoader(Allocator& allocator, std::size_t threadCount) : _allocator(allocator),
+																			 _uploadContext(nullptr),
+																			 _pendingCount(0),
+																			 _stop(false)
+	{
+		if (threadCount == 0)
+			threadCount = std::max(1u, std::thread::hardware_concurrency() / 4);
+		_workers.reserve(threadCount);
+		for (std::size_t i = 0; i < threadCount; ++i)
+			_workers.emplace_back(&MeshLoader::run, this);
+	}
+
+	MeshLoader::MeshLoader(UploadContext& uploadContext, std::size_t threadCount) : MeshLoader(
+			uploadContext.getAllocator(), threadCount)
+	{
+		_uploadContext = &uploadContext;
+	}
+
+	MeshLoader::~MeshLoader()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_condition.notify_all();
+		for (std::thread& worker : _workers)
+			worker.join();
+	}
+
+	std::future<std::unique_ptr<Mesh>> MeshLoader::loadAsync(const std::string& file, VkBufferUsageFlags usage,
+			VmaMemoryUsage memoryUsage, const MeshLoadOptions& options)
+	{
+		return queue({ file, usage, memoryUsage, options, nullptr, {}, std::nullopt });
+	}
+
+	std::future<std::unique_ptr<Mesh>> MeshLoader::loadAsync(const std::string& file, GeometryArena& arena,
+			const MeshLoadOptions& options)
+	{
+		if (!_uploadContext)
+			throw std::logic_error("MeshLoader: arena meshes need an UploadContext");
+		return queue({ file, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY, options, &arena, {},
+					   std::nullopt });
+	}
+
+	std::future<std::unique_ptr<Mesh>> MeshLoader::queue(Job job)
+	{
+		std::future<std::unique_ptr<Mesh>> future = job.promise.get_future();
+		++_pendingCount;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_jobs.push_back(std::move(job));
+		}
+		_condition.notify_one();
+		return future;
+	}
+
+	std::size_t MeshLoader::update(std::size_t byteBudget)
+	{
+		std::size_t uploadedBytes = 0;
+		std::size_t uploadedCount = 0;
+		while (uploadedCount == 0 || uploadedBytes < byteBudget)
+		{
+			Job job;
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				if (_parsed.empty())
+					break;
+				job = std::move(_parsed.front());
+				_parsed.pop_front();
+			}
+			uploadedBytes += job.data->getUploadSize();
+			try
+			{
+				if (job.arena)
+					job.promise.set_value(std::make_unique<Mesh>(std::move(*job.data), *job.arena, *_uploadContext));
+				else if (_uploadContext && job.memoryUsage == VMA_MEMORY_USAGE_GPU_ONLY)
+					job.promise.set_value(std::make_unique<Mesh>(std::move(*job.data), *_uploadContext, job.usage));
+				else
+					job.promise.set_value(std::make_unique<Mesh>(std::move(*job.data), _allocator, job.usage,
+							job.memoryUsage));
+			}
+			catch (...)
+			{
+				job.promise.set_exception(std::current_exception());
+			}
+			--_pendingCount;
+			++uploadedCount;
+		}
+		if (_uploadContext && uploadedCount != 0)
+			_uploadContext->submit();
+		return uploadedCount;
+	}
+
+	std::size_t MeshLoader::getPendingCount() const
+	{
+		return _pendingCount;
+	}
+
+	void MeshLoader::run()
+	{
+		while (true)
+		{
+			Job job;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_condition.wait(lock, [this]() { return _stop || !_jobs.empty(); });
+				if (_stop)
+					return;
+				job = std::move(_jobs.front());
+				_jobs.pop_front();
+			}
+			try
+			{
+				job.data.emplace(job.file, job.options);
+			}
+			catch (...)
+			{
+				std::cerr << "MeshLoader: unable to load " << job.file << std::endl;
+				job.promise.set_exception(std::current_exception());
+				--_pendingCount;
+				continue;
+			}
+			std::lock_guard<std::mutex> lock(_mutex);
+			_parsed.push_back(std::move(job));
+		}
+	}
+} // Concerto::Graphics::Wrapper
@@ -0,0 +1,277 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/MeshOptimizer.hpp"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace Concerto::Graphics::Wrapper
+{
+	namespace
+	{
+		constexpr std::uint32_t InvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+		struct TriangleAdjacency
+		{
+			std::vector<std::uint32_t> offsets;
+			std::vector<std::uint32_t> counts;
+			std::vector<std::uint32_t> triangles;
+		};
+
+		TriangleAdjacency buildAdjacency(std::span<const std::uint32_t> indices, std::size_t vertexCount)
+		{
+			TriangleAdjacency adjacency;
+			adjacency.counts.assign(vertexCount, 0);
+			adjacency.offsets.assign(vertexCount, 0);
+			adjacency.triangles.resize(indices.size());
+			for (std::uint32_t index: indices)
+				++adjacency.counts[index];
+			std::exclusive_scan(adjacency.counts.begin(), adjacency.counts.end(), adjacency.offsets.begin(), 0u);
+
+			std::vector<std::uint32_t> fill = adjacency.offsets;
+			for (std::size_t i = 0; i < indices.size(); ++i)
+				adjacency.triangles[fill[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+			return adjacency;
+		}
+
+		// A vertex is in the FIFO cache when less than cacheSize misses happened since it was loaded
+		std::size_t updateCache(std::uint32_t vertex, std::size_t cacheSize, std::vector<std::size_t>& timestamps,
+				std::size_t& timestamp)
+		{
+			if (timestamp - timestamps[vertex] > cacheSize)
+			{
+				timestamps[vertex] = timestamp++;
+				return 1;
+			}
+			return 0;
+		}
+
+		std::size_t updateCache(const std::uint32_t* triangle, std::size_t cacheSize,
+				std::vector<std::size_t>& timestamps, std::size_t& timestamp)
+		{
+			return updateCache(triangle[0], cacheSize, timestamps, timestamp) +
+				   updateCache(triangle[1], cacheSize, timestamps, timestamp) +
+				   updateCache(triangle[2], cacheSize, timestamps, timestamp);
+		}
+
+		std::uint32_t skipDeadEnd(std::vector<std::uint32_t>& deadEnd, const std::vector<std::uint32_t>& live,
+				std::size_t& cursor)
+		{
+			while (!deadEnd.empty())
+			{
+				std::uint32_t vertex = deadEnd.back();
+				deadEnd.pop_back();
+				if (live[vertex] > 0)
+					return vertex;
+			}
+			for (; cursor < live.size(); ++cursor)
+			{
+				if (live[cursor] > 0)
+					return static_cast<std::uint32_t>(cursor);
+			}
+			return InvalidIndex;
+		}
+	}
+
+	VertexCacheStatistics analyzeVertexCache(std::span<const std::uint32_t> indices, std::size_t vertexCount,
+			std::size_t cacheSize)
+	{
+		std::vector<std::size_t> timestamps(vertexCount, 0);
+		std::vector<bool> referenced(vertexCount, false);
+		std::size_t timestamp = cacheSize + 1;
+		std::size_t misses = 0;
+		std::size_t referencedCount = 0;
+		for (std::uint32_t index: indices)
+		{
+			misses += updateCache(index, cacheSize, timestamps, timestamp);
+			if (!referenced[index])
+			{
+				referenced[index] = true;
+				++referencedCount;
+			}
+		}
+		const std::size_t triangleCount = indices.size() / 3;
+		return {
+				triangleCount == 0 ? 0.f : static_cast<float>(misses) / static_cast<float>(triangleCount),
+				referencedCount == 0 ? 0.f : static_cast<float>(misses) / static_cast<float>(referencedCount)
+		};
+	}
+
+	Indices optimizeVertexCache(std::span<const std::uint32_t> indices, std::size_t vertexCount, std::size_t cacheSize)
+	{
+		Indices result;
+		result.reserve(indices.size());
+		TriangleAdjacency adjacency = buildAdjacency(indices, vertexCount);
+		std::vector<std::uint32_t> live = adjacency.counts;
+		std::vector<std::size_t> cacheTime(vertexCount, 0);
+		std::vector<bool> emitted(indices.size() / 3, false);
+		std::vector<std::uint32_t> deadEnd;
+		std::vector<std::uint32_t> candidates;
+		std::size_t timestamp = cacheSize + 1;
+		std::size_t cursor = 0;
+
+		std::uint32_t fanning = skipDeadEnd(deadEnd, live, cursor);
+		while (fanning != InvalidIndex)
+		{
+			candidates.clear();
+			const std::uint32_t* begin = adjacency.triangles.data() + adjacency.offsets[fanning];
+			const std::uint32_t* end = begin + adjacency.counts[fanning];
+			for (const std::uint32_t* triangle = begin; triangle != end; ++triangle)
+			{
+				if (emitted[*triangle])
+					continue;
+				for (std::size_t corner = 0; corner < 3; ++corner)
+				{
+					std::uint32_t vertex = indices[*triangle * 3 + corner];
+					result.push_back(vertex);
+					deadEnd.push_back(vertex);
+					candidates.push_back(vertex);
+					--live[vertex];
+					if (timestamp - cacheTime[vertex] > cacheSize)
+						cacheTime[vertex] = timestamp++;
+				}
+				emitted[*triangle] = true;
+			}
+
+			// Prefer the candidate that will still be in the cache after its remaining triangles are emitted
+			std::uint32_t best = InvalidIndex;
+			std::size_t bestPriority = 0;
+			for (std::uint32_t vertex: candidates)
+			{
+				if (live[vertex] == 0)
+					continue;
+				std::size_t priority = 1;
+				if (timestamp - cacheTime[vertex] + 2 * live[vertex] <= cacheSize)
+					priority += timestamp - cacheTime[vertex];
+				if (priority > bestPriority)
+				{
+					best = vertex;
+					bestPriority = priority;
+				}
+			}
+			fanning = best != InvalidIndex ? best : skipDeadEnd(deadEnd, live, cursor);
+		}
+		return result;
+	}
+
+	Indices optimizeOverdraw(std::span<const std::uint32_t> indices, std::span<const Vertex> vertices,
+			float threshold, std::size_t cacheSize)
+	{
+		const std::size_t triangleCount = indices.size() / 3;
+		if (triangleCount == 0)
+			return { indices.begin(), indices.end() };
+		std::vector<std::size_t> timestamps(vertices.size(), 0);
+		std::size_t timestamp = cacheSize + 1;
+
+		// A triangle missing all its vertices starts a new patch of the mesh
+		std::vector<std::size_t> hardBoundaries;
+		for (std::size_t i = 0; i < triangleCount; ++i)
+		{
+			if (updateCache(&indices[i * 3], cacheSize, timestamps, timestamp) == 3 || i == 0)
+				hardBoundaries.push_back(i);
+		}
+		hardBoundaries.push_back(triangleCount);
+
+		// Split each patch further as long as the sub clusters keep an ACMR close to the patch one
+		std::vector<std::size_t> clusters;
+		for (std::size_t patch = 0; patch + 1 < hardBoundaries.size(); ++patch)
+		{
+			const std::size_t start = hardBoundaries[patch];
+			const std::size_t end = hardBoundaries[patch + 1];
+			timestamp += cacheSize + 1;
+			std::size_t patchMisses = 0;
+			for (std::size_t i = start; i < end; ++i)
+				patchMisses += updateCache(&indices[i * 3], cacheSize, timestamps, timestamp);
+			const float clusterThreshold = threshold * static_cast<float>(patchMisses) / static_cast<float>(end - start);
+
+			timestamp += cacheSize + 1;
+			std::size_t runningMisses = 0;
+			std::size_t runningTriangles = 0;
+			clusters.push_back(start);
+			for (std::size_t i = start; i < end; ++i)
+			{
+				runningMisses += updateCache(&indices[i * 3], cacheSize, timestamps, timestamp);
+				++runningTriangles;
+				if (i + 1 < end &&
+					static_cast<float>(runningMisses) / static_cast<float>(runningTriangles) <= clusterThreshold)
+				{
+					clusters.push_back(i + 1);
+					timestamp += cacheSize + 1;
+					runningMisses = 0;
+					runningTriangles = 0;
+				}
+			}
+		}
+		clusters.push_back(triangleCount);
+
+		struct Cluster
+		{
+			std::size_t begin;
+			std::size_t end;
+			float sortKey;
+		};
+		std::vector<Cluster> sortedClusters(clusters.size() - 1);
+		std::vector<glm::vec3> centroids(sortedClusters.size(), glm::vec3(0.f));
+		std::vector<glm::vec3> normals(sortedClusters.size(), glm::vec3(0.f));
+		glm::vec3 meshCentroid(0.f);
+		float meshArea = 0.f;
+		for (std::size_t cluster = 0; cluster < sortedClusters.size(); ++cluster)
+		{
+			float clusterArea = 0.f;
+			for (std::size_t i = clusters[cluster]; i < clusters[cluster + 1]; ++i)
+			{
+				const glm::vec3& p0 = vertices[indices[i * 3 + 0]].position;
+				const glm::vec3& p1 = vertices[indices[i * 3 + 1]].position;
+				const glm::vec3& p2 = vertices[indices[i * 3 + 2]].position;
+				const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+				const float area = glm::length(normal);
+				centroids[cluster] += (p0 + p1 + p2) * (area / 3.f);
+				normals[cluster] += normal;
+				clusterArea += area;
+			}
+			meshCentroid += centroids[cluster];
+			meshArea += clusterArea;
+			if (clusterArea > 0.f)
+				centroids[cluster] /= clusterArea;
+			sortedClusters[cluster] = { clusters[cluster], clusters[cluster + 1], 0.f };
+		}
+		if (meshArea > 0.f)
+			meshCentroid /= meshArea;
+		for (std::size_t cluster = 0; cluster < sortedClusters.size(); ++cluster)
+		{
+			const float length = glm::length(normals[cluster]);
+			if (length > 0.f)
+				sortedClusters[cluster].sortKey = glm::dot(centroids[cluster] - meshCentroid, normals[cluster] / length);
+		}
+		std::stable_sort(sortedClusters.begin(), sortedClusters.end(), [](const Cluster& a, const Cluster& b)
+		{
+			return a.sortKey > b.sortKey;
+		});
+
+		Indices result;
+		result.reserve(indices.size());
+		for (const Cluster& cluster: sortedClusters)
+			result.insert(result.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+		return result;
+	}
+
+	void optimizeVertexFetch(Vertices& vertices, Indices& indices)
+	{
+		std::vector<std::uint32_t> remap(vertices.size(), InvalidIndex);
+		Vertices result;
+		result.reserve(vertices.size());
+		for (std::uint32_t& index: indices)
+		{
+			if (remap[index] == InvalidIndex)
+			{
+				remap[index] = static_cast<std::uint32_t>(result.size());
+				result.push_back(vertices[index]);
+			}
+			index = remap[index];
+		}
+		vertices = std::move(result);
+	}
+}
\ No newline at end of file
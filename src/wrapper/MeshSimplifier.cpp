@@ -0,0 +1,285 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/MeshSimplifier.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace Concerto::Graphics::Wrapper
+{
+	namespace
+	{
+		struct Quadric
+		{
+			double a00, a01, a02, a03;
+			double a11, a12, a13;
+			double a22, a23;
+			double a33;
+			double weight;
+		};
+
+		Quadric makePlaneQuadric(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2)
+		{
+			glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+			float length = glm::length(normal);
+			if (length == 0.f)
+				return {};
+			normal /= length;
+			// Weighted by area so that small triangles do not pin large flat regions
+			const double w = length * 0.5;
+			const double x = normal.x, y = normal.y, z = normal.z;
+			const double d = -glm::dot(normal, p0);
+			return { x * x * w, x * y * w, x * z * w, x * d * w,
+					 y * y * w, y * z * w, y * d * w,
+					 z * z * w, z * d * w,
+					 d * d * w,
+					 w };
+		}
+
+		void addQuadric(Quadric& quadric, const Quadric& other)
+		{
+			quadric.a00 += other.a00;
+			quadric.a01 += other.a01;
+			quadric.a02 += other.a02;
+			quadric.a03 += other.a03;
+			quadric.a11 += other.a11;
+			quadric.a12 += other.a12;
+			quadric.a13 += other.a13;
+			quadric.a22 += other.a22;
+			quadric.a23 += other.a23;
+			quadric.a33 += other.a33;
+			quadric.weight += other.weight;
+		}
+
+		// Mean squared distance from position to the planes accumulated in quadric
+		float evaluateQuadric(const Quadric& quadric, const glm::vec3& position)
+		{
+			if (quadric.weight <= 0.0)
+				return 0.f;
+			const double x = position.x, y = position.y, z = position.z;
+			double error = quadric.a00 * x * x + quadric.a11 * y * y + quadric.a22 * z * z +
+						   2.0 * (quadric.a01 * x * y + quadric.a02 * x * z + quadric.a12 * y * z) +
+						   2.0 * (quadric.a03 * x + quadric.a13 * y + quadric.a23 * z) + quadric.a33;
+			return static_cast<float>(std::max(error, 0.0) / quadric.weight);
+		}
+
+		struct PositionHash
+		{
+			std::size_t operator()(const glm::vec3& position) const noexcept
+			{
+				std::uint32_t bits[3];
+				std::memcpy(bits, &position, sizeof(bits));
+				return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+			}
+		};
+
+		// Every vertex is mapped to the first vertex that has the same position
+		std::vector<std::uint32_t> buildPositionRemap(std::span<const Vertex> vertices)
+		{
+			std::vector<std::uint32_t> remap(vertices.size());
+			std::unordered_map<glm::vec3, std::uint32_t, PositionHash> firstVertex;
+			firstVertex.reserve(vertices.size());
+			for (std::size_t i = 0; i < vertices.size(); ++i)
+				remap[i] = firstVertex.try_emplace(vertices[i].position, static_cast<std::uint32_t>(i)).first->second;
+			return remap;
+		}
+
+		std::vector<bool> findBorderVertices(std::span<const std::uint32_t> indices,
+				const std::vector<std::uint32_t>& remap)
+		{
+			// An edge without its opposite half-edge is on an open border
+			auto key = [](std::uint32_t a, std::uint32_t b)
+			{
+				return (static_cast<std::uint64_t>(a) << 32) | b;
+			};
+			std::unordered_map<std::uint64_t, std::uint32_t> edges;
+			edges.reserve(indices.size());
+			for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+			{
+				for (std::size_t e = 0; e < 3; ++e)
+					++edges[key(remap[indices[i + e]], remap[indices[i + (e + 1) % 3]])];
+			}
+			std::vector<bool> border(remap.size(), false);
+			for (const auto& [edge, count]: edges)
+			{
+				auto a = static_cast<std::uint32_t>(edge >> 32);
+				auto b = static_cast<std::uint32_t>(edge & 0xFFFFFFFFu);
+				if (edges.find(key(b, a)) == edges.end())
+					border[a] = border[b] = true;
+			}
+			return border;
+		}
+
+		// Positions shared by vertices with different normals or texture coordinates, the attributes of their
+		// corners depend on the side of the seam their triangle is on
+		void lockSeamVertices(std::span<const Vertex> vertices, const std::vector<std::uint32_t>& remap,
+				std::vector<bool>& locked)
+		{
+			for (std::size_t i = 0; i < vertices.size(); ++i)
+			{
+				if (!(vertices[i] == vertices[remap[i]]))
+					locked[remap[i]] = true;
+			}
+		}
+
+		struct Collapse
+		{
+			std::uint32_t from;
+			std::uint32_t to;
+			std::uint32_t toVertex; // vertex at the position to on the side of the collapsed edge
+			float error;
+		};
+
+		bool flipsTriangles(const Collapse& collapse, const Indices& triangles, std::span<const Vertex> vertices,
+				const std::vector<std::uint32_t>& offsets, const std::vector<std::uint32_t>& adjacency)
+		{
+			for (std::uint32_t i = offsets[collapse.from]; i < offsets[collapse.from + 1]; ++i)
+			{
+				const std::uint32_t* triangle = &triangles[adjacency[i] * 3];
+				if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+					continue;
+				glm::vec3 before[3], after[3];
+				for (int corner = 0; corner < 3; ++corner)
+				{
+					before[corner] = vertices[triangle[corner]].position;
+					after[corner] = triangle[corner] == collapse.from ? vertices[collapse.to].position : before[corner];
+				}
+				glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+				glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+				// Rotating a triangle by more than ~75 degrees folds it over its neighbours even if it does not flip
+				if (glm::dot(normalBefore, normalAfter) <= 0.25f * glm::length(normalBefore) * glm::length(normalAfter))
+					return true;
+			}
+			return false;
+		}
+	}
+
+	Indices simplifyMesh(std::span<const std::uint32_t> indices, std::span<const Vertex> vertices,
+			std::size_t targetIndexCount, float targetError, float* resultError)
+	{
+		const std::vector<std::uint32_t> remap = buildPositionRemap(vertices);
+		std::vector<bool> locked = findBorderVertices(indices, remap);
+		lockSeamVertices(vertices, remap, locked);
+
+		std::vector<Quadric> quadrics(vertices.size(), Quadric{});
+		for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			const std::uint32_t a = remap[indices[i]], b = remap[indices[i + 1]], c = remap[indices[i + 2]];
+			Quadric quadric = makePlaneQuadric(vertices[a].position, vertices[b].position, vertices[c].position);
+			addQuadric(quadrics[a], quadric);
+			addQuadric(quadrics[b], quadric);
+			addQuadric(quadrics[c], quadric);
+		}
+
+		// A trailing incomplete triangle is dropped, every loop below reads whole triangles
+		Indices result(indices.begin(), indices.begin() + static_cast<std::ptrdiff_t>(indices.size() / 3 * 3));
+		const float maxSquaredError = targetError < std::sqrt(std::numeric_limits<float>::max())
+									  ? targetError * targetError : std::numeric_limits<float>::max();
+		float squaredError = 0.f;
+		Indices triangles;
+		std::vector<Collapse> collapses;
+		std::vector<std::uint32_t> offsets;
+		std::vector<std::uint32_t> adjacency;
+		std::vector<std::uint32_t> collapseTarget(vertices.size());
+		std::vector<std::uint32_t> collapseVertex(vertices.size());
+		std::vector<bool> touched(vertices.size());
+
+		// Each pass sorts every candidate collapse by cost and applies the cheapest independent ones
+		while (result.size() > targetIndexCount)
+		{
+			triangles.resize(result.size());
+			for (std::size_t i = 0; i < result.size(); ++i)
+				triangles[i] = remap[result[i]];
+
+			offsets.assign(vertices.size() + 1, 0);
+			for (std::uint32_t vertex: triangles)
+				++offsets[vertex + 1];
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+			adjacency.resize(triangles.size());
+			std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+			for (std::size_t i = 0; i < triangles.size(); ++i)
+				adjacency[fill[triangles[i]]++] = static_cast<std::uint32_t>(i / 3);
+
+			collapses.clear();
+			for (std::size_t i = 0; i < triangles.size(); i += 3)
+			{
+				for (std::size_t e = 0; e < 3; ++e)
+				{
+					const std::size_t from = i + e, to = i + (e + 1) % 3;
+					for (auto [u, v]: { std::pair{ from, to }, std::pair{ to, from } })
+					{
+						if (locked[triangles[u]])
+							continue;
+						Quadric quadric = quadrics[triangles[u]];
+						addQuadric(quadric, quadrics[triangles[v]]);
+						collapses.push_back({ triangles[u], triangles[v], result[v],
+											  evaluateQuadric(quadric, vertices[triangles[v]].position) });
+					}
+				}
+			}
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b)
+			{
+				return a.error < b.error;
+			});
+
+			std::iota(collapseTarget.begin(), collapseTarget.end(), 0u);
+			std::fill(touched.begin(), touched.end(), false);
+			const std::size_t trianglesToRemove = (result.size() - targetIndexCount + 2) / 3;
+			std::size_t removedTriangles = 0;
+			std::size_t collapseCount = 0;
+			for (const Collapse& collapse: collapses)
+			{
+				if (collapse.error > maxSquaredError || removedTriangles >= trianglesToRemove)
+					break;
+				if (touched[collapse.from] || touched[collapse.to])
+					continue;
+				if (flipsTriangles(collapse, triangles, vertices, offsets, adjacency))
+					continue;
+				collapseTarget[collapse.from] = collapse.to;
+				collapseVertex[collapse.from] = collapse.toVertex;
+				addQuadric(quadrics[collapse.to], quadrics[collapse.from]);
+				squaredError = std::max(squaredError, collapse.error);
+				++collapseCount;
+				// The one-ring of from changes shape, its vertices wait for the next pass
+				for (std::uint32_t i = offsets[collapse.from]; i < offsets[collapse.from + 1]; ++i)
+				{
+					const std::uint32_t* triangle = &triangles[adjacency[i] * 3];
+					touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = true;
+					if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+						++removedTriangles;
+				}
+			}
+			if (collapseCount == 0)
+				break;
+
+			std::size_t write = 0;
+			for (std::size_t i = 0; i < result.size(); i += 3)
+			{
+				std::uint32_t corners[3];
+				std::uint32_t positions[3];
+				for (std::size_t corner = 0; corner < 3; ++corner)
+				{
+					const std::uint32_t position = remap[result[i + corner]];
+					const std::uint32_t target = collapseTarget[position];
+					// from is not on a seam, all its triangles are on the side of the edge it collapsed along
+					corners[corner] = target == position ? result[i + corner] : collapseVertex[position];
+					positions[corner] = target;
+				}
+				if (positions[0] == positions[1] || positions[1] == positions[2] || positions[0] == positions[2])
+					continue;
+				result[write++] = corners[0];
+				result[write++] = corners[1];
+				result[write++] = corners[2];
+			}
+			result.resize(write);
+		}
+		if (resultError)
+			*resultError = std::sqrt(squaredError);
+		return result;
+	}
+}
\ No newline at end of file
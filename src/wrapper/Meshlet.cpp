@@ -0,0 +1,153 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/Meshlet.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Concerto::Graphics::Wrapper
+{
+	namespace
+	{
+		void computeMeshletBounds(Meshlet& meshlet, std::span<const std::uint32_t> indices,
+				std::span<const Vertex> vertices, std::span<const std::uint32_t> meshletVertices)
+		{
+			std::vector<glm::vec3> positions;
+			positions.reserve(meshletVertices.size());
+			for (std::uint32_t vertex: meshletVertices)
+				positions.push_back(vertices[vertex].position);
+			meshlet.boundingSphere = computeBoundingSphere(positions);
+
+			// Degenerate triangles keep a null normal and take no part in the cone
+			std::vector<glm::vec3> normals(meshlet.triangleCount, glm::vec3(0.f));
+			glm::vec3 axis(0.f);
+			const std::uint32_t* triangle = indices.data() + meshlet.firstIndex;
+			for (std::uint32_t i = 0; i < meshlet.triangleCount; ++i, triangle += 3)
+			{
+				const glm::vec3& p0 = vertices[triangle[0]].position;
+				glm::vec3 normal = glm::cross(vertices[triangle[1]].position - p0, vertices[triangle[2]].position - p0);
+				float area = glm::length(normal);
+				if (area == 0.f)
+					continue;
+				normals[i] = normal / area;
+				axis += normals[i];
+			}
+
+			meshlet.coneApex = meshlet.boundingSphere.center;
+			meshlet.coneAxis = glm::vec3(0.f);
+			meshlet.coneCutoff = 1.f;
+			float axisLength = glm::length(axis);
+			if (axisLength == 0.f)
+				return;
+			axis /= axisLength;
+			float minDot = 1.f;
+			for (const glm::vec3& normal: normals)
+			{
+				if (normal != glm::vec3(0.f))
+					minDot = std::min(minDot, glm::dot(normal, axis));
+			}
+			// A cone wider than a hemisphere is visible from everywhere
+			if (minDot <= 0.f)
+				return;
+
+			// Move the apex back along the axis until every triangle plane is in front of it
+			float maxT = 0.f;
+			triangle = indices.data() + meshlet.firstIndex;
+			for (std::uint32_t i = 0; i < meshlet.triangleCount; ++i, triangle += 3)
+			{
+				if (normals[i] == glm::vec3(0.f))
+					continue;
+				const glm::vec3& p0 = vertices[triangle[0]].position;
+				float t = glm::dot(meshlet.boundingSphere.center - p0, normals[i]) / glm::dot(axis, normals[i]);
+				maxT = std::max(maxT, t);
+			}
+			meshlet.coneApex = meshlet.boundingSphere.center - axis * maxT;
+			meshlet.coneAxis = axis;
+			meshlet.coneCutoff = std::sqrt(1.f - minDot * minDot);
+		}
+	}
+
+	Meshlets buildMeshlets(std::span<const std::uint32_t> indices, std::span<const Vertex> vertices,
+			std::size_t maxVertices, std::size_t maxTriangles)
+	{
+		Meshlets meshlets;
+		meshlets.reserve(indices.size() / 3 / maxTriangles + 1);
+		// owner[v] is the index of the last meshlet that referenced v, so starting a meshlet needs no reset
+		std::vector<std::uint32_t> owner(vertices.size(), ~0u);
+		std::vector<std::uint32_t> meshletVertices;
+		meshletVertices.reserve(maxVertices);
+		Meshlet meshlet{};
+
+		auto flush = [&]()
+		{
+			if (meshlet.triangleCount == 0)
+				return;
+			meshlet.vertexCount = static_cast<std::uint32_t>(meshletVertices.size());
+			computeMeshletBounds(meshlet, indices, vertices, meshletVertices);
+			meshlets.push_back(meshlet);
+			meshlet = {};
+			meshletVertices.clear();
+		};
+
+		for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			const std::uint32_t a = indices[i], b = indices[i + 1], c = indices[i + 2];
+			auto current = static_cast<std::uint32_t>(meshlets.size());
+			std::size_t newVertices = (owner[a] != current) + (owner[b] != current && b != a) +
+									  (owner[c] != current && c != a && c != b);
+			if (meshletVertices.size() + newVertices > maxVertices || meshlet.triangleCount + 1 > maxTriangles)
+			{
+				flush();
+				current = static_cast<std::uint32_t>(meshlets.size());
+			}
+			if (meshlet.triangleCount == 0)
+				meshlet.firstIndex = static_cast<std::uint32_t>(i);
+			for (std::uint32_t vertex: { a, b, c })
+			{
+				if (owner[vertex] != current)
+				{
+					owner[vertex] = current;
+					meshletVertices.push_back(vertex);
+				}
+			}
+			++meshlet.triangleCount;
+		}
+		flush();
+		return meshlets;
+	}
+
+	MeshletCullingStatistics cullMeshlets(std::span<const Meshlet> meshlets, const Frustum& frustum,
+			const glm::vec3& cameraPosition, std::vector<IndexRange>& ranges)
+	{
+		MeshletCullingStatistics statistics{};
+		const std::size_t firstRange = ranges.size();
+		for (const Meshlet& meshlet: meshlets)
+		{
+			if (!intersects(frustum, meshlet.boundingSphere))
+			{
+				statistics.frustumCulledTriangles += meshlet.triangleCount;
+				continue;
+			}
+			// Every triangle faces away when the camera sits inside the cone mirrored behind the apex
+			if (meshlet.coneCutoff < 1.f)
+			{
+				glm::vec3 direction = meshlet.coneApex - cameraPosition;
+				float distance = glm::length(direction);
+				if (distance > 0.f && glm::dot(direction, meshlet.coneAxis) >= meshlet.coneCutoff * distance)
+				{
+					statistics.backfaceCulledTriangles += meshlet.triangleCount;
+					continue;
+				}
+			}
+			++statistics.visibleMeshlets;
+			statistics.visibleTriangles += meshlet.triangleCount;
+			const std::uint32_t indexCount = meshlet.triangleCount * 3;
+			if (ranges.size() > firstRange && ranges.back().firstIndex + ranges.back().indexCount == meshlet.firstIndex)
+				ranges.back().indexCount += indexCount;
+			else
+				ranges.push_back({ meshlet.firstIndex, indexCount });
+		}
+		return statistics;
+	}
+}
\ No newline at end of file
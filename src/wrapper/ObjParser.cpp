@@ -0,0 +1,585 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/ObjParser.hpp"
+
+#define TINYOBJLOADER_IMPLEMENTATION
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "tiny_obj_loader.h"
+#include "wrapper/MappedFile.hpp"
+
+namespace Concerto::Graphics::Wrapper
+{
+	namespace
+	{
+		// Below this size the thread start-up costs more than the parsing itself
+		constexpr std::size_t MinChunkSize = 1 << 20;
+
+		constexpr std::uint8_t RelativePosition = 1 << 0;
+		constexpr std::uint8_t RelativeTexcoord = 1 << 1;
+		constexpr std::uint8_t RelativeNormal = 1 << 2;
+		constexpr std::uint8_t HasTexcoord = 1 << 3;
+		constexpr std::uint8_t HasNormal = 1 << 4;
+
+		// Face corner as written in the file, relative indices are kept relative to the chunk
+		struct Corner
+		{
+			std::int32_t position;
+			std::int32_t texcoord;
+			std::int32_t normal;
+			std::uint8_t flags;
+		};
+
+		struct Chunk
+		{
+			const char* begin;
+			const char* end;
+			std::vector<glm::vec3> positions;
+			std::vector<glm::vec2> texcoords;
+			std::vector<glm::vec3> normals;
+			std::vector<Corner> corners;
+			std::vector<std::uint8_t> faceSizes;
+			std::size_t triangleCount = 0;
+			std::size_t positionBase = 0;
+			std::size_t texcoordBase = 0;
+			std::size_t normalBase = 0;
+			std::size_t vertexBase = 0;
+			ObjParser::Result result = ObjParser::Result::Success;
+		};
+
+		template<typename Function>
+		void parallelFor(std::size_t count, Function&& function)
+		{
+			std::vector<std::thread> threads;
+			threads.reserve(count > 0 ? count - 1 : 0);
+			for (std::size_t i = 1; i < count; ++i)
+				threads.emplace_back(function, i);
+			if (count > 0)
+				function(0);
+			for (auto& thread: threads)
+				thread.join();
+		}
+
+		bool isBlank(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r';
+		}
+
+		const char* skipBlanks(const char* it, const char* end)
+		{
+			while (it < end && isBlank(*it))
+				++it;
+			return it;
+		}
+
+		bool isDigit(char c)
+		{
+			return c >= '0' && c <= '9';
+		}
+
+		// tinyobj's table of negative powers of ten, it calls std::pow past the 8th decimal
+		const std::array<double, 32> NegativePowers = []()
+		{
+			std::array<double, 32> powers = {1.0, 0.1, 0.01, 0.001, 0.0001, 0.00001, 0.000001, 0.0000001};
+			for (std::size_t i = 8; i < powers.size(); ++i)
+				powers[i] = std::pow(10.0, -static_cast<int>(i));
+			return powers;
+		}();
+
+		// tinyobj's tryParseDouble, it does not always round correctly (std::from_chars does) so the same
+		// arithmetic is needed to produce the same floats
+		bool parseDouble(const char* it, const char* end, double& result)
+		{
+			if (it >= end)
+				return false;
+			double mantissa = 0.0;
+			int exponent = 0;
+			bool negative = false;
+			bool leadingDot = false;
+			if (*it == '+' || *it == '-')
+			{
+				negative = *it == '-';
+				++it;
+				leadingDot = it != end && *it == '.';
+			}
+			else if (*it == '.')
+				leadingDot = true;
+			else if (!isDigit(*it))
+				return false;
+
+			if (!leadingDot)
+			{
+				const char* digits = it;
+				for (; it < end && isDigit(*it); ++it)
+				{
+					mantissa *= 10;
+					mantissa += static_cast<int>(*it - '0');
+				}
+				if (it == digits)
+					return false;
+			}
+			if (it < end && *it == '.')
+			{
+				++it;
+				for (int read = 1; it < end && isDigit(*it); ++read, ++it)
+					mantissa += static_cast<int>(*it - '0') *
+								(static_cast<std::size_t>(read) < NegativePowers.size() ? NegativePowers[read] : std::pow(10.0, -read));
+			}
+			if (it < end && (*it == 'e' || *it == 'E'))
+			{
+				++it;
+				bool negativeExponent = false;
+				if (it < end && (*it == '+' || *it == '-'))
+				{
+					negativeExponent = *it == '-';
+					++it;
+				}
+				const char* digits = it;
+				for (; it < end && isDigit(*it); ++it)
+				{
+					if (exponent > 2147483647 / 10)
+						return false;
+					exponent = exponent * 10 + static_cast<int>(*it - '0');
+				}
+				if (it == digits)
+					return false;
+				if (negativeExponent)
+					exponent = -exponent;
+			}
+			result = (negative ? -1 : 1) * (exponent ? std::ldexp(mantissa * std::pow(5.0, exponent), exponent)
+													 : mantissa);
+			return true;
+		}
+
+		// tinyobj parses doubles and narrows them to real_t (float), do the same
+		float parseFloat(const char*& it, const char* end)
+		{
+			it = skipBlanks(it, end);
+			const char* token = it;
+			while (it < end && !isBlank(*it))
+				++it;
+			double value = 0.0;
+			parseDouble(token, it, value);
+			return static_cast<float>(value);
+		}
+
+		bool parseIndex(const char*& it, const char* end, std::size_t localCount, std::int32_t& index, bool& relative)
+		{
+			std::int32_t value = 0;
+			auto [ptr, error] = std::from_chars(it, end, value);
+			if (error != std::errc() || value == 0)
+				return false;
+			it = ptr;
+			relative = value < 0;
+			index = relative ? static_cast<std::int32_t>(localCount) + value : value - 1;
+			return true;
+		}
+
+		bool parseCorner(const char*& it, const char* end, const Chunk& chunk, Corner& corner)
+		{
+			bool relative = false;
+			corner = {};
+			if (!parseIndex(it, end, chunk.positions.size(), corner.position, relative))
+				return false;
+			if (relative)
+				corner.flags |= RelativePosition;
+			if (it == end || *it != '/')
+				return true;
+			++it;
+			if (it < end && *it != '/')
+			{
+				if (!parseIndex(it, end, chunk.texcoords.size(), corner.texcoord, relative))
+					return false;
+				corner.flags |= HasTexcoord | (relative ? RelativeTexcoord : 0);
+			}
+			if (it == end || *it != '/')
+				return true;
+			++it;
+			if (!parseIndex(it, end, chunk.normals.size(), corner.normal, relative))
+				return false;
+			corner.flags |= HasNormal | (relative ? RelativeNormal : 0);
+			return true;
+		}
+
+		void parseFace(const char* it, const char* end, Chunk& chunk)
+		{
+			Corner corners[4];
+			std::size_t count = 0;
+			it = skipBlanks(it, end);
+			while (it < end)
+			{
+				Corner corner{};
+				if (!parseCorner(it, end, chunk, corner))
+				{
+					chunk.result = ObjParser::Result::Error;
+					return;
+				}
+				if (count == 4)
+				{
+					chunk.result = ObjParser::Result::Unsupported;
+					return;
+				}
+				corners[count++] = corner;
+				it = skipBlanks(it, end);
+			}
+			// tinyobj drops degenerated faces
+			if (count < 3)
+				return;
+			chunk.corners.insert(chunk.corners.end(), corners, corners + count);
+			chunk.faceSizes.push_back(static_cast<std::uint8_t>(count));
+			chunk.triangleCount += count - 2;
+		}
+
+		void parseLine(const char* it, const char* end, Chunk& chunk)
+		{
+			it = skipBlanks(it, end);
+			if (end - it < 2)
+				return;
+			if (it[0] == 'v' && isBlank(it[1]))
+			{
+				it += 2;
+				glm::vec3 position;
+				position.x = parseFloat(it, end);
+				position.y = parseFloat(it, end);
+				position.z = parseFloat(it, end);
+				chunk.positions.push_back(position);
+			}
+			else if (it[0] == 'v' && it[1] == 'n' && end - it > 2 && isBlank(it[2]))
+			{
+				it += 3;
+				glm::vec3 normal;
+				normal.x = parseFloat(it, end);
+				normal.y = parseFloat(it, end);
+				normal.z = parseFloat(it, end);
+				chunk.normals.push_back(normal);
+			}
+			else if (it[0] == 'v' && it[1] == 't' && end - it > 2 && isBlank(it[2]))
+			{
+				it += 3;
+				glm::vec2 texcoord;
+				texcoord.x = parseFloat(it, end);
+				texcoord.y = parseFloat(it, end);
+				chunk.texcoords.push_back(texcoord);
+			}
+			else if (it[0] == 'f' && isBlank(it[1]))
+				parseFace(it + 2, end, chunk);
+		}
+
+		void parseChunk(Chunk& chunk)
+		{
+			const char* it = chunk.begin;
+			while (it < chunk.end && chunk.result == ObjParser::Result::Success)
+			{
+				const auto* lineEnd = static_cast<const char*>(std::memchr(it, '\n', chunk.end - it));
+				if (lineEnd == nullptr)
+					lineEnd = chunk.end;
+				// comments
+				const auto* comment = static_cast<const char*>(std::memchr(it, '#', lineEnd - it));
+				parseLine(it, comment != nullptr ? comment : lineEnd, chunk);
+				it = lineEnd + 1;
+			}
+		}
+
+		struct Attributes
+		{
+			std::vector<glm::vec3> positions;
+			std::vector<glm::vec2> texcoords;
+			std::vector<glm::vec3> normals;
+		};
+
+		bool resolve(std::int32_t index, bool relative, std::size_t base, std::size_t size, std::size_t& resolved)
+		{
+			const std::int64_t value = static_cast<std::int64_t>(index) + (relative ? static_cast<std::int64_t>(base) : 0);
+			if (value < 0 || static_cast<std::size_t>(value) >= size)
+				return false;
+			resolved = static_cast<std::size_t>(value);
+			return true;
+		}
+
+		bool makeVertex(const Corner& corner, const Chunk& chunk, const Attributes& attributes, Vertex& vertex)
+		{
+			std::size_t index = 0;
+			if (!resolve(corner.position, corner.flags & RelativePosition, chunk.positionBase,
+					attributes.positions.size(), index))
+				return false;
+			vertex.position = attributes.positions[index];
+			vertex.normal = glm::vec3(0.f);
+			if (corner.flags & HasNormal)
+			{
+				if (!resolve(corner.normal, corner.flags & RelativeNormal, chunk.normalBase, attributes.normals.size(),
+						index))
+					return false;
+				vertex.normal = attributes.normals[index];
+			}
+			//we are setting the vertex color as the vertex normal. This is just for display purposes
+			vertex.color = vertex.normal;
+			glm::vec2 texcoord(0.f);
+			if (corner.flags & HasTexcoord)
+			{
+				if (!resolve(corner.texcoord, corner.flags & RelativeTexcoord, chunk.texcoordBase,
+						attributes.texcoords.size(), index))
+					return false;
+				texcoord = attributes.texcoords[index];
+			}
+			vertex.uv.x = texcoord.x;
+			vertex.uv.y = 1 - texcoord.y;
+			return true;
+		}
+
+		float squaredDistance(const glm::vec3& a, const glm::vec3& b)
+		{
+			const float x = b.x - a.x;
+			const float y = b.y - a.y;
+			const float z = b.z - a.z;
+			return x * x + y * y + z * z;
+		}
+
+		bool emitTriangles(const Chunk& chunk, const Attributes& attributes, Vertex* output)
+		{
+			const Corner* corner = chunk.corners.data();
+			for (std::uint8_t faceSize: chunk.faceSizes)
+			{
+				Vertex v[4];
+				for (std::uint8_t i = 0; i < faceSize; ++i)
+				{
+					if (!makeVertex(corner[i], chunk, attributes, v[i]))
+						return false;
+				}
+				if (faceSize == 3)
+				{
+					*output++ = v[0];
+					*output++ = v[1];
+					*output++ = v[2];
+				}
+				else if (squaredDistance(v[0].position, v[2].position) < squaredDistance(v[1].position, v[3].position))
+				{
+					// same split as tinyobj: keep the shortest diagonal
+					*output++ = v[0];
+					*output++ = v[1];
+					*output++ = v[2];
+					*output++ = v[0];
+					*output++ = v[2];
+					*output++ = v[3];
+				}
+				else
+				{
+					*output++ = v[0];
+					*output++ = v[1];
+					*output++ = v[3];
+					*output++ = v[1];
+					*output++ = v[2];
+					*output++ = v[3];
+				}
+				corner += faceSize;
+			}
+			return true;
+		}
+
+		template<typename T>
+		void gather(std::vector<T>& destination, const std::vector<T>& source, std::size_t base)
+		{
+			if (!source.empty())
+				std::memcpy(destination.data() + base, source.data(), source.size() * sizeof(T));
+		}
+	}
+
+	ObjParser::ObjParser(std::size_t threadCount) : _threadCount(threadCount),
+													_parsedBytes(0),
+													_parseTime(0.0)
+	{
+		if (_threadCount == 0)
+			_threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	ObjParser::Result ObjParser::parse(const std::string& fileName, Vertices& vertices)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		MappedFile file;
+		if (!file.open(fileName))
+		{
+			std::cerr << "ObjParser: unable to open " << fileName << std::endl;
+			return Result::Error;
+		}
+		const char* data = reinterpret_cast<const char*>(file.data());
+		const std::size_t size = file.size();
+
+		// Split at line boundaries
+		const std::size_t chunkCount = std::clamp<std::size_t>(size / MinChunkSize, 1, _threadCount);
+		std::vector<Chunk> chunks(chunkCount);
+		const char* begin = data;
+		for (std::size_t i = 0; i < chunkCount; ++i)
+		{
+			const char* end = data + size * (i + 1) / chunkCount;
+			if (i + 1 < chunkCount)
+			{
+				const auto* newLine = static_cast<const char*>(std::memchr(end, '\n', data + size - end));
+				end = newLine != nullptr ? newLine + 1 : data + size;
+			}
+			chunks[i].begin = begin;
+			chunks[i].end = std::max(begin, end);
+			begin = chunks[i].end;
+		}
+
+		parallelFor(chunkCount, [&](std::size_t i)
+		{
+			parseChunk(chunks[i]);
+		});
+
+		Attributes attributes;
+		std::size_t vertexCount = 0;
+		for (Chunk& chunk: chunks)
+		{
+			if (chunk.result != Result::Success)
+				return chunk.result;
+			chunk.positionBase = attributes.positions.size();
+			chunk.texcoordBase = attributes.texcoords.size();
+			chunk.normalBase = attributes.normals.size();
+			chunk.vertexBase = vertexCount;
+			attributes.positions.resize(attributes.positions.size() + chunk.positions.size());
+			attributes.texcoords.resize(attributes.texcoords.size() + chunk.texcoords.size());
+			attributes.normals.resize(attributes.normals.size() + chunk.normals.size());
+			vertexCount += chunk.triangleCount * 3;
+		}
+
+		vertices.clear();
+		vertices.resize(vertexCount);
+		std::vector<char> succeeded(chunkCount, 1);
+		parallelFor(chunkCount, [&](std::size_t i)
+		{
+			gather(attributes.positions, chunks[i].positions, chunks[i].positionBase);
+			gather(attributes.texcoords, chunks[i].texcoords, chunks[i].texcoordBase);
+			gather(attributes.normals, chunks[i].normals, chunks[i].normalBase);
+		});
+		parallelFor(chunkCount, [&](std::size_t i)
+		{
+			succeeded[i] = emitTriangles(chunks[i], attributes, vertices.data() + chunks[i].vertexBase);
+		});
+		if (std::find(succeeded.begin(), succeeded.end(), 0) != succeeded.end())
+		{
+			std::cerr << "ObjParser: face with invalid index in " << fileName << std::endl;
+			vertices.clear();
+			return Result::Error;
+		}
+
+		_parsedBytes = size;
+		_parseTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return Result::Success;
+	}
+
+	bool ObjParser::parseWithTinyObj(const std::string& fileName, const std::string& materialPath,
+			Vertices& vertices)
+	{
+		vertices.clear();
+		std::string err;
+		tinyobj::ObjReaderConfig readerConfig;
+		tinyobj::ObjReader reader;
+
+		readerConfig.mtl_search_path = materialPath;
+		if (!reader.ParseFromFile(fileName, readerConfig))
+		{
+			if (!reader.Error().empty())
+			{
+				std::cerr << "TinyObjReader error: " << reader.Error() << std::endl;
+				return false;
+			}
+		}
+		if (!reader.Warning().empty())
+		{
+			std::cout << "TinyObjReader: " << reader.Warning();
+		}
+
+		if (!err.empty())
+		{
+			std::cerr << err << std::endl;
+		}
+
+		auto& attrib = reader.GetAttrib();
+		auto& shapes = reader.GetShapes();
+
+		std::size_t faceCount = 0;
+		for (auto& shape: shapes)
+			faceCount += shape.mesh.num_face_vertices.size();
+		vertices.reserve(faceCount * 3);
+
+		for (auto& shape: shapes)
+		{
+			// Loop over faces(polygon)
+			std::size_t index_offset = 0;
+			for (std::size_t f = 0; f < shape.mesh.num_face_vertices.size(); f++)
+			{
+				//hardcode loading to triangles
+				const std::size_t fv = 3;
+				// Loop over vertices in the face.
+				for (std::size_t v = 0; v < fv; v++)
+				{
+					// access to vertex
+					tinyobj::index_t idx = shape.mesh.indices[index_offset + v];
+
+					//vertex position
+					tinyobj::real_t vx = attrib.vertices[3 * idx.vertex_index + 0];
+					tinyobj::real_t vy = attrib.vertices[3 * idx.vertex_index + 1];
+					tinyobj::real_t vz = attrib.vertices[3 * idx.vertex_index + 2];
+					//vertex normal
+					tinyobj::real_t nx = attrib.normals[3 * idx.normal_index + 0];
+					tinyobj::real_t ny = attrib.normals[3 * idx.normal_index + 1];
+					tinyobj::real_t nz = attrib.normals[3 * idx.normal_index + 2];
+
+					//copy it into our vertex
+					Vertex new_vert{};
+					new_vert.position.x = vx;
+					new_vert.position.y = vy;
+					new_vert.position.z = vz;
+
+					new_vert.normal.x = nx;
+					new_vert.normal.y = ny;
+					new_vert.normal.z = nz;
+
+					//we are setting the vertex color as the vertex normal. This is just for display purposes
+					new_vert.color = new_vert.normal;
+					//vertex uv
+					tinyobj::real_t ux = attrib.texcoords[2 * idx.texcoord_index + 0];
+					tinyobj::real_t uy = attrib.texcoords[2 * idx.texcoord_index + 1];
+
+					new_vert.uv.x = ux;
+					new_vert.uv.y = 1 - uy;
+					vertices.push_back(new_vert);
+				}
+				index_offset += fv;
+			}
+		}
+		return true;
+	}
+
+	std::size_t ObjParser::getThreadCount() const
+	{
+		return _threadCount;
+	}
+
+	std::size_t ObjParser::getParsedBytes() const
+	{
+		return _parsedBytes;
+	}
+
+	double ObjParser::getParseTime() const
+	{
+		return _parseTime;
+	}
+
+	double ObjParser::getThroughput() const
+	{
+		if (_parseTime <= 0.0)
+			return 0.0;
+		return static_cast<double>(_parsedBytes) / (1024.0 * 1024.0) / _parseTime;
+	}
+}
\ No newline at end of file
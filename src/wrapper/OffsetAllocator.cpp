@@ -0,0 +1,108 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/OffsetAllocator.hpp"
+
+#include <cassert>
+#include <iterator>
+
+namespace Concerto::Graphics::Wrapper
+{
+	OffsetAllocator::OffsetAllocator(std::uint64_t size) : _size(size), _freeSize(0)
+	{
+		if (size != 0)
+			insertFreeRange(0, size);
+	}
+
+	std::optional<std::uint64_t> OffsetAllocator::allocate(std::uint64_t size, std::uint64_t alignment)
+	{
+		if (size == 0 || alignment == 0)
+			return std::nullopt;
+		// Smallest range that still fits once its start is aligned
+		for (auto it = _freeBySize.lower_bound(size); it != _freeBySize.end(); ++it)
+		{
+			const std::uint64_t rangeOffset = it->second;
+			const std::uint64_t rangeSize = it->first;
+			const std::uint64_t padding = (alignment - rangeOffset % alignment) % alignment;
+			if (padding + size > rangeSize)
+				continue;
+			eraseFreeRange(_freeByOffset.find(rangeOffset));
+			if (padding != 0)
+				insertFreeRange(rangeOffset, padding);
+			if (padding + size < rangeSize)
+				insertFreeRange(rangeOffset + padding + size, rangeSize - padding - size);
+			return rangeOffset + padding;
+		}
+		return std::nullopt;
+	}
+
+	void OffsetAllocator::free(std::uint64_t offset, std::uint64_t size)
+	{
+		if (size == 0)
+			return;
+		assert(offset + size <= _size);
+		auto next = _freeByOffset.lower_bound(offset);
+		assert(next == _freeByOffset.end() || next->first >= offset + size);
+		if (next != _freeByOffset.end() && next->first == offset + size)
+		{
+			size += next->second;
+			auto erased = next++;
+			eraseFreeRange(erased);
+		}
+		if (next != _freeByOffset.begin())
+		{
+			auto previous = std::prev(next);
+			assert(previous->first + previous->second <= offset);
+			if (previous->first + previous->second == offset)
+			{
+				offset = previous->first;
+				size += previous->second;
+				eraseFreeRange(previous);
+			}
+		}
+		insertFreeRange(offset, size);
+	}
+
+	std::uint64_t OffsetAllocator::getSize() const
+	{
+		return _size;
+	}
+
+	std::uint64_t OffsetAllocator::getFreeSize() const
+	{
+		return _freeSize;
+	}
+
+	std::uint64_t OffsetAllocator::getLargestFreeRange() const
+	{
+		return _freeBySize.empty() ? 0 : _freeBySize.rbegin()->first;
+	}
+
+	std::size_t OffsetAllocator::getFreeRangeCount() const
+	{
+		return _freeByOffset.size();
+	}
+
+	void OffsetAllocator::insertFreeRange(std::uint64_t offset, std::uint64_t size)
+	{
+		_freeByOffset.emplace(offset, size);
+		_freeBySize.emplace(size, offset);
+		_freeSize += size;
+	}
+
+	void OffsetAllocator::eraseFreeRange(std::map<std::uint64_t, std::uint64_t>::iterator it)
+	{
+		auto [first, last] = _freeBySize.equal_range(it->second);
+		for (; first != last; ++first)
+		{
+			if (first->second == it->first)
+			{
+				_freeBySize.erase(first);
+				break;
+			}
+		}
+		_freeSize -= it->second;
+		_freeByOffset.erase(it);
+	}
+} // Concerto::Graphics::Wrapper
@@ -0,0 +1,151 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/ParallelRecorder.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Concerto::Graphics::Wrapper
+{
+	ParallelRecorder::ParallelRecorder(VkDevice device, std::uint32_t queueFamily, std::size_t frameCount,
+			std::size_t threadCount, std::size_t minChunkSize) : _device(device),
+																 _threadCount(threadCount),
+																 _minChunkSize(std::max<std::size_t>(minChunkSize, 1)),
+																 _frameIndex(0),
+																 _generation(0),
+																 _remaining(0),
+																 _stop(false),
+																 _recordFunction(nullptr),
+																 _inheritanceInfo(nullptr),
+																 _count(0),
+																 _chunkCount(0),
+																 _frameStatistics()
+	{
+		if (_threadCount == 0)
+			_threadCount = std::max(1u, std::thread::hardware_concurrency());
+		_frames.resize(frameCount);
+		for (std::vector<std::unique_ptr<CommandAllocator>>& frame : _frames)
+		{
+			frame.reserve(_threadCount);
+			for (std::size_t i = 0; i < _threadCount; ++i)
+				frame.push_back(std::make_unique<CommandAllocator>(_device, queueFamily));
+		}
+		_recorded.resize(_threadCount);
+		_recordedStatistics.resize(_threadCount);
+		// The calling thread records the first chunk
+		_workers.reserve(_threadCount - 1);
+		for (std::size_t i = 1; i < _threadCount; ++i)
+			_workers.emplace_back(&ParallelRecorder::run, this, i);
+	}
+
+	ParallelRecorder::~ParallelRecorder()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_condition.notify_all();
+		for (std::thread& worker : _workers)
+			worker.join();
+	}
+
+	void ParallelRecorder::beginFrame(std::size_t frameIndex)
+	{
+		assert(frameIndex < _frames.size());
+		_frameIndex = frameIndex;
+		_frameStatistics = {};
+		for (std::unique_ptr<CommandAllocator>& commandAllocator : _frames[_frameIndex])
+			commandAllocator->reset();
+	}
+
+	void ParallelRecorder::record(CommandBuffer& commandBuffer, const VkCommandBufferInheritanceInfo& inheritanceInfo,
+			std::size_t count, const RecordFunction& recordFunction)
+	{
+		if (count == 0)
+			return;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_recordFunction = &recordFunction;
+			_inheritanceInfo = &inheritanceInfo;
+			_count = count;
+			_chunkCount = std::min(_threadCount, (count + _minChunkSize - 1) / _minChunkSize);
+			_remaining = _chunkCount - 1;
+			_error = nullptr;
+			++_generation;
+		}
+		if (_chunkCount > 1)
+			_condition.notify_all();
+		recordChunk(0);
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_doneCondition.wait(lock, [this]()
+			{
+				return _remaining == 0;
+			});
+			_recordFunction = nullptr;
+			_inheritanceInfo = nullptr;
+			if (_error)
+				std::rethrow_exception(_error);
+		}
+		for (std::size_t i = 0; i < _chunkCount; ++i)
+			addStateStatistics(_frameStatistics, _recordedStatistics[i]);
+		commandBuffer.executeCommands({ _recorded.data(), _chunkCount });
+	}
+
+	std::size_t ParallelRecorder::getThreadCount() const
+	{
+		return _threadCount;
+	}
+
+	const StateStatistics& ParallelRecorder::getStateStatistics() const
+	{
+		return _frameStatistics;
+	}
+
+	void ParallelRecorder::run(std::size_t thread)
+	{
+		std::uint64_t generation = 0;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_condition.wait(lock, [&]()
+				{
+					return _stop || _generation != generation;
+				});
+				if (_stop)
+					return;
+				generation = _generation;
+				if (thread >= _chunkCount)
+					continue;
+			}
+			recordChunk(thread);
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (--_remaining == 0)
+				_doneCondition.notify_one();
+		}
+	}
+
+	void ParallelRecorder::recordChunk(std::size_t thread)
+	{
+		try
+		{
+			CommandBuffer& commandBuffer = _frames[_frameIndex][thread]->allocate(VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+			const std::size_t first = _count * thread / _chunkCount;
+			const std::size_t last = _count * (thread + 1) / _chunkCount;
+			commandBuffer.begin(*_inheritanceInfo);
+			(*_recordFunction)(commandBuffer, first, last);
+			commandBuffer.end();
+			_recorded[thread] = commandBuffer.get();
+			_recordedStatistics[thread] = commandBuffer.getStateStatistics();
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (!_error)
+				_error = std::current_exception();
+		}
+	}
+} // Concerto::Graphics::Wrapper
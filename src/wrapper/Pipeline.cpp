@@ -6,6 +6,7 @@
 #include <iostream>
 #include <utility>
 #include "wrapper/Pipeline.hpp"
+#include "wrapper/HostAllocator.hpp"
 #include "wrapper/VulkanInitializer.hpp"
 
 namespace Concerto::Graphics::Wrapper
@@ -26,7 +27,6 @@ namespace Concerto::Graphics::Wrapper
 		VkGraphicsPipelineCreateInfo pipelineInfo{};
 		VkPipelineColorBlendStateCreateInfo colorBlending{};
 		VkPipelineViewportStateCreateInfo viewportState{};
-		VkPipelineColorBlendAttachmentState colorBlendAttachment(VulkanInitializer::ColorBlendAttachmentState());
 
 		viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
 		viewportState.pNext = nullptr;
@@ -40,7 +40,7 @@ namespace Concerto::Graphics::Wrapper
 		colorBlending.logicOpEnable = VK_FALSE;
 		colorBlending.logicOp = VK_LOGIC_OP_COPY;
 		colorBlending.attachmentCount = 1;
-		colorBlending.pAttachments = &colorBlendAttachment;
+		colorBlending.pAttachments = &_pipelineInfo._colorBlendAttachment;
 
 		pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
 		pipelineInfo.pNext = nullptr;
@@ -60,7 +60,7 @@ namespace Concerto::Graphics::Wrapper
 		pipelineInfo.pDepthStencilState = &_pipelineInfo._depthStencil;
 
 
-		if (vkCreateGraphicsPipelines(_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &_pipeline) != VK_SUCCESS)
+		if (vkCreateGraphicsPipelines(_device, VK_NULL_HANDLE, 1, &pipelineInfo, HostAllocator::getCallbacks(), &_pipeline) != VK_SUCCESS)
 		{
 			std::cerr << "failed to create pipeline\n";
 			return VK_NULL_HANDLE;
@@ -99,7 +99,7 @@ namespace Concerto::Graphics::Wrapper
 
 	Pipeline::~Pipeline()
 	{
-		vkDestroyPipeline(_device, _pipeline, nullptr);
+		vkDestroyPipeline(_device, _pipeline, HostAllocator::getCallbacks());
 		_pipeline = VK_NULL_HANDLE;
 	}
 
@@ -3,6 +3,7 @@
 //
 
 #include "wrapper/PipelineLayout.hpp"
+#include "wrapper/HostAllocator.hpp"
 #include <stdexcept>
 #include "wrapper/VulkanInitializer.hpp"
 
@@ -10,7 +11,8 @@ namespace Concerto::Graphics::Wrapper
 {
 
 	PipelineLayout::PipelineLayout(VkDevice device, std::size_t size,
-			const std::vector<std::reference_wrapper<DescriptorSetLayout>>& descriptorSetLayouts) : _device(device)
+			const std::vector<std::reference_wrapper<DescriptorSetLayout>>& descriptorSetLayouts,
+			VkShaderStageFlags pushConstantStages) : _device(device)
 	{
 		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
 		VkPushConstantRange push_constant;
@@ -22,7 +24,7 @@ namespace Concerto::Graphics::Wrapper
 		}
 		push_constant.offset = 0;
 		push_constant.size = size;
-		push_constant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		push_constant.stageFlags = pushConstantStages;
 		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 		pipelineLayoutCreateInfo.pNext = nullptr;
 		pipelineLayoutCreateInfo.flags = 0;
@@ -30,7 +32,7 @@ namespace Concerto::Graphics::Wrapper
 		pipelineLayoutCreateInfo.pSetLayouts = set_layout.data();
 		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
 		pipelineLayoutCreateInfo.pPushConstantRanges = &push_constant;
-		if (vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, nullptr, &_pipelineLayout) != VK_SUCCESS)
+		if (vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, HostAllocator::getCallbacks(), &_pipelineLayout) != VK_SUCCESS)
 		{
 			throw std::runtime_error("failed to create pipeline layout!");
 		}
@@ -38,7 +40,7 @@ namespace Concerto::Graphics::Wrapper
 
 	PipelineLayout::~PipelineLayout()
 	{
-		vkDestroyPipelineLayout(_device, _pipelineLayout, nullptr);
+		vkDestroyPipelineLayout(_device, _pipelineLayout, HostAllocator::getCallbacks());
 		_pipelineLayout = VK_NULL_HANDLE;
 	}
 
@@ -6,6 +6,7 @@
 #include <stdexcept>
 
 #include "wrapper/RenderPass.hpp"
+#include "wrapper/HostAllocator.hpp"
 
 namespace Concerto::Graphics::Wrapper
 {
@@ -23,7 +24,7 @@ namespace Concerto::Graphics::Wrapper
 		render_pass_info.dependencyCount = dependencies.size();
 		render_pass_info.pDependencies = dependencies.data();
 
-		if (vkCreateRenderPass(_device, &render_pass_info, nullptr, &_renderPass) != VK_SUCCESS)
+		if (vkCreateRenderPass(_device, &render_pass_info, HostAllocator::getCallbacks(), &_renderPass) != VK_SUCCESS)
 		{
 			throw std::runtime_error("failed to create render pass!");
 		}
@@ -31,7 +32,7 @@ namespace Concerto::Graphics::Wrapper
 
 	RenderPass::~RenderPass()
 	{
-		vkDestroyRenderPass(_device, _renderPass, nullptr);
+		vkDestroyRenderPass(_device, _renderPass, HostAllocator::getCallbacks());
 		_renderPass = VK_NULL_HANDLE;
 	}
 
@@ -4,6 +4,7 @@
 
 
 #include "wrapper/Semaphore.hpp"
+#include "wrapper/HostAllocator.hpp"
 #include <stdexcept>
 
 namespace Concerto::Graphics::Wrapper
@@ -15,7 +16,7 @@ namespace Concerto::Graphics::Wrapper
 		info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 		info.pNext = nullptr;
 		info.flags = 0;
-		if (vkCreateSemaphore(_device, &info, nullptr, &_semaphore) != VK_SUCCESS)
+		if (vkCreateSemaphore(_device, &info, HostAllocator::getCallbacks(), &_semaphore) != VK_SUCCESS)
 		{
 			throw std::runtime_error("Failed to create semaphore");
 		}
@@ -23,7 +24,7 @@ namespace Concerto::Graphics::Wrapper
 
 	Semaphore::~Semaphore()
 	{
-		vkDestroySemaphore(_device, _semaphore, nullptr);
+		vkDestroySemaphore(_device, _semaphore, HostAllocator::getCallbacks());
 		_semaphore = VK_NULL_HANDLE;
 	}
 
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <exception>
 #include "wrapper/ShaderModule.hpp"
+#include "wrapper/HostAllocator.hpp"
 
 namespace Concerto::Graphics::Wrapper
 {
@@ -18,7 +19,7 @@ namespace Concerto::Graphics::Wrapper
 
 	ShaderModule::~ShaderModule()
 	{
-		vkDestroyShaderModule(_device, _shaderModule, nullptr);
+		vkDestroyShaderModule(_device, _shaderModule, HostAllocator::getCallbacks());
 		_shaderModule = VK_NULL_HANDLE;
 	}
 
@@ -40,7 +41,7 @@ namespace Concerto::Graphics::Wrapper
 
 	void ShaderModule::createShaderModule()
 	{
-		if (vkCreateShaderModule(_device, &_shaderModuleCreateInfo, nullptr, &_shaderModule) != VK_SUCCESS)
+		if (vkCreateShaderModule(_device, &_shaderModuleCreateInfo, HostAllocator::getCallbacks(), &_shaderModule) != VK_SUCCESS)
 		{
 			throw std::runtime_error("Failed to create shader module");
 		}
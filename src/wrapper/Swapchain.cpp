@@ -7,6 +7,7 @@
 #include "vulkan/vulkan.h"
 #include "VkBootstrap.h"
 #include "vk_mem_alloc.h"
+#include "wrapper/HostAllocator.hpp"
 #include "wrapper/VulkanInitializer.hpp"
 
 namespace Concerto::Graphics::Wrapper
@@ -22,6 +23,7 @@ namespace Concerto::Graphics::Wrapper
 						//use vsync present mode
 				.set_desired_present_mode(VK_PRESENT_MODE_FIFO_KHR)
 				.set_desired_extent(_windowExtent.width, _windowExtent.height)
+				.set_allocation_callbacks(HostAllocator::getCallbacks())
 				.build()
 				.value();
 		_swapChain = vkbSwapChain.swapchain;
@@ -44,12 +46,14 @@ namespace Concerto::Graphics::Wrapper
 		dimg_allocinfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
 		dimg_allocinfo.requiredFlags = VkMemoryPropertyFlags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-		vmaCreateImage(allocator._allocator, &dimg_info, &dimg_allocinfo, &_depthImage._image, &_depthImage._allocation, nullptr);
+		VmaAllocationInfo depthAllocationInfo = {};
+		vmaCreateImage(allocator._allocator, &dimg_info, &dimg_allocinfo, &_depthImage._image, &_depthImage._allocation, &depthAllocationInfo);
+		_allocator.trackAllocation(MemoryTag::Image, depthAllocationInfo.size);
 
 		VkImageViewCreateInfo dview_info = VulkanInitializer::ImageViewCreateInfo(_depthFormat, _depthImage._image,
 				VK_IMAGE_ASPECT_DEPTH_BIT);;
 
-		if(vkCreateImageView(_device, &dview_info, nullptr, &_depthImageView) != VK_SUCCESS)
+		if(vkCreateImageView(_device, &dview_info, HostAllocator::getCallbacks(), &_depthImageView) != VK_SUCCESS)
 		{
 			throw std::runtime_error("Failed to create depth image view");
 		}
@@ -57,8 +61,11 @@ namespace Concerto::Graphics::Wrapper
 
 	Swapchain::~Swapchain()
 	{
+		VmaAllocationInfo depthAllocationInfo = {};
+		vmaGetAllocationInfo(_allocator._allocator, _depthImage._allocation, &depthAllocationInfo);
+		_allocator.untrackAllocation(MemoryTag::Image, depthAllocationInfo.size);
 		vmaDestroyImage(_allocator._allocator, _depthImage._image, _depthImage._allocation);
-		vkDestroySwapchainKHR(_device, _swapChain, nullptr);
+		vkDestroySwapchainKHR(_device, _swapChain, HostAllocator::getCallbacks());
 		_swapChain = VK_NULL_HANDLE;
 	}
 
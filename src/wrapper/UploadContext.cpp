@@ -0,0 +1,183 @@
+//
+// Created by arthur on 16/10/2026.
+//
+
+#include "wrapper/UploadContext.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace Concerto::Graphics::Wrapper
+{
+	namespace
+	{
+		constexpr std::size_t StagingAlignment = 16;
+
+		constexpr std::size_t alignStaging(std::size_t size)
+		{
+			return (size + StagingAlignment - 1) & ~(StagingAlignment - 1);
+		}
+	}
+
+	UploadContext::Batch::Batch(VkDevice device, VkCommandPool commandPool) : fence(device, false),
+																			   commandBuffer(device, commandPool),
+																			   stagingUsed(0)
+	{
+	}
+
+	UploadContext::UploadContext(Allocator& allocator, VkDevice device, VkQueue queue, std::uint32_t queueFamily,
+			std::size_t stagingSize) : _allocator(allocator),
+									   _device(device),
+									   _queue(queue),
+									   _commandPool(device, queueFamily),
+									   _current(0),
+									   _recording(false),
+									   _stagingBuffer(allocator, stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+											   VMA_MEMORY_USAGE_CPU_TO_GPU, VMA_ALLOCATION_CREATE_MAPPED_BIT),
+									   _stagingData(nullptr),
+									   _stagingSize(stagingSize & ~(StagingAlignment - 1)),
+									   _stagingHead(0),
+									   _stagingUsed(0),
+									   _recordingUsed(0)
+	{
+		if (_stagingSize == 0)
+			throw std::runtime_error("UploadContext: staging ring too small");
+		_batches.reserve(BatchCount);
+		for (std::size_t i = 0; i < BatchCount; ++i)
+			_batches.push_back(std::make_unique<Batch>(device, _commandPool.get()));
+		if (!_stagingBuffer.isMapped())
+			throw std::runtime_error("UploadContext: unable to map the staging ring");
+		_stagingData = _stagingBuffer.getMappedData().data();
+	}
+
+	UploadContext::~UploadContext()
+	{
+		flush();
+	}
+
+	void UploadContext::upload(const AllocatedBuffer& buffer, VkDeviceSize offset, std::span<const std::byte> data)
+	{
+		upload(buffer._buffer, offset, data);
+	}
+
+	void UploadContext::upload(const PooledBuffer& buffer, VkDeviceSize offset, std::span<const std::byte> data)
+	{
+		assert(offset + data.size() <= buffer.getSize());
+		upload(buffer.getBuffer(), buffer.getOffset() + offset, data);
+	}
+
+	void UploadContext::upload(VkBuffer buffer, VkDeviceSize offset, std::span<const std::byte> data)
+	{
+		// Data larger than the ring goes through it in several pieces
+		while (!data.empty())
+		{
+			std::size_t size = std::min(data.size(), _stagingSize);
+			VkDeviceSize stagingOffset = allocateStaging(size);
+			Batch& batch = getRecordingBatch();
+			std::memcpy(_stagingData + stagingOffset, data.data(), size);
+			VkBufferCopy region = { stagingOffset, offset, size };
+			batch.commandBuffer.copyBuffer(_stagingBuffer._buffer, buffer, { &region, 1 });
+			offset += size;
+			data = data.subspan(size);
+		}
+	}
+
+	void UploadContext::submit()
+	{
+		if (!_recording)
+			return;
+		Batch& batch = *_batches[_current];
+		batch.commandBuffer.memoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+				VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+				VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+				VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT);
+		batch.commandBuffer.end();
+		_stagingBuffer.flush();
+
+		VkCommandBuffer vkCommandBuffer = batch.commandBuffer.get();
+		VkSubmitInfo submitInfo = {};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.pNext = nullptr;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &vkCommandBuffer;
+		if (vkQueueSubmit(_queue, 1, &submitInfo, batch.fence.get()) != VK_SUCCESS)
+		{
+			throw std::runtime_error("vkQueueSubmit fail");
+		}
+		batch.stagingUsed = _recordingUsed;
+		_recordingUsed = 0;
+		_recording = false;
+		_inFlight.push_back(_current);
+		_current = (_current + 1) % BatchCount;
+		while (!_inFlight.empty() && _batches[_inFlight.front()]->fence.isSignaled())
+			retireOldestBatch();
+	}
+
+	void UploadContext::flush()
+	{
+		submit();
+		while (!_inFlight.empty())
+			retireOldestBatch();
+	}
+
+	Allocator& UploadContext::getAllocator() const
+	{
+		return _allocator;
+	}
+
+	VkDeviceSize UploadContext::allocateStaging(std::size_t size)
+	{
+		const std::size_t alignedSize = alignStaging(size);
+		while (true)
+		{
+			if (_stagingUsed == 0)
+				_stagingHead = 0;
+			std::size_t offset = _stagingHead;
+			std::size_t wasted = 0;
+			if (offset + alignedSize > _stagingSize)
+			{
+				// Skip the end of the ring, it is given back with the batch
+				wasted = _stagingSize - offset;
+				offset = 0;
+			}
+			if (_stagingUsed + wasted + alignedSize <= _stagingSize)
+			{
+				_stagingHead = offset + alignedSize;
+				_stagingUsed += wasted + alignedSize;
+				_recordingUsed += wasted + alignedSize;
+				return offset;
+			}
+			// The batch being recorded holds the whole ring
+			if (_inFlight.empty())
+				submit();
+			retireOldestBatch();
+		}
+	}
+
+	UploadContext::Batch& UploadContext::getRecordingBatch()
+	{
+		Batch& batch = *_batches[_current];
+		if (_recording)
+			return batch;
+		// Batches are used in turn, if this one is still in flight it is the oldest
+		if (!_inFlight.empty() && _inFlight.front() == _current)
+			retireOldestBatch();
+		batch.commandBuffer.reset();
+		batch.commandBuffer.begin();
+		_recording = true;
+		return batch;
+	}
+
+	void UploadContext::retireOldestBatch()
+	{
+		Batch& batch = *_batches[_inFlight.front()];
+		batch.fence.wait(std::numeric_limits<std::uint64_t>::max());
+		batch.fence.reset();
+		_stagingUsed -= batch.stagingUsed;
+		batch.stagingUsed = 0;
+		_inFlight.pop_front();
+	}
+} // Concerto::Graphics::Wrapper
@@ -4,6 +4,7 @@
 
 
 #include "wrapper/Vertex.hpp"
+#include <glm/gtc/packing.hpp>
 
 namespace Concerto::Graphics::Wrapper
 {
@@ -45,4 +46,173 @@ namespace Concerto::Graphics::Wrapper
 		description.attributes.push_back(colorAttribute);
 		return description;
 	}
+
+	VertexInputDescription Vertex::getSplitVertexDescription()
+	{
+		VertexInputDescription description = getPositionVertexDescription();
+
+		VkVertexInputBindingDescription attributeBinding = {};
+		attributeBinding.binding = 1;
+		attributeBinding.stride = sizeof(VertexAttributes);
+		attributeBinding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+		description.bindings.push_back(attributeBinding);
+
+		VkVertexInputAttributeDescription normalAttribute = {};
+		normalAttribute.binding = 1;
+		normalAttribute.location = 1;
+		normalAttribute.format = VK_FORMAT_R32G32B32_SFLOAT;
+		normalAttribute.offset = offsetof(VertexAttributes, normal);
+
+		VkVertexInputAttributeDescription colorAttribute = {};
+		colorAttribute.binding = 1;
+		colorAttribute.location = 2;
+		colorAttribute.format = VK_FORMAT_R32G32B32_SFLOAT;
+		colorAttribute.offset = offsetof(VertexAttributes, color);
+
+		VkVertexInputAttributeDescription uvAttribute = {};
+		uvAttribute.binding = 1;
+		uvAttribute.location = 3;
+		uvAttribute.format = VK_FORMAT_R32G32_SFLOAT;
+		uvAttribute.offset = offsetof(VertexAttributes, uv);
+
+		description.attributes.push_back(normalAttribute);
+		description.attributes.push_back(colorAttribute);
+		description.attributes.push_back(uvAttribute);
+		return description;
+	}
+
+	VertexInputDescription Vertex::getPositionVertexDescription()
+	{
+		VertexInputDescription description {};
+
+		VkVertexInputBindingDescription positionBinding = {};
+		positionBinding.binding = 0;
+		positionBinding.stride = sizeof(glm::vec3);
+		positionBinding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+		description.bindings.push_back(positionBinding);
+
+		VkVertexInputAttributeDescription positionAttribute = {};
+		positionAttribute.binding = 0;
+		positionAttribute.location = 0;
+		positionAttribute.format = VK_FORMAT_R32G32B32_SFLOAT;
+		positionAttribute.offset = 0;
+
+		description.attributes.push_back(positionAttribute);
+		return description;
+	}
+
+	VertexInputDescription getVertexDescription(VertexFormat format)
+	{
+		switch (format)
+		{
+		case VertexFormat::Packed:
+			return PackedVertex::getVertexDescription();
+		case VertexFormat::Split:
+			return Vertex::getSplitVertexDescription();
+		default:
+			return Vertex::getVertexDescription();
+		}
+	}
+
+	std::size_t getVertexStride(VertexFormat format)
+	{
+		switch (format)
+		{
+		case VertexFormat::Packed:
+			return sizeof(PackedVertex);
+		case VertexFormat::Split:
+			return sizeof(glm::vec3) + sizeof(VertexAttributes);
+		default:
+			return sizeof(Vertex);
+		}
+	}
+
+	VertexInputDescription PackedVertex::getVertexDescription()
+	{
+		VertexInputDescription description {};
+
+		VkVertexInputBindingDescription mainBinding = {};
+		mainBinding.binding = 0;
+		mainBinding.stride = sizeof(PackedVertex);
+		mainBinding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+		description.bindings.push_back(mainBinding);
+
+		//Position will be stored at Location 0, R16G16B16 is not a mandatory vertex format so we fetch
+		//4 components, the fourth one overlaps the normal and is ignored by the shader
+		VkVertexInputAttributeDescription positionAttribute = {};
+		positionAttribute.binding = 0;
+		positionAttribute.location = 0;
+		positionAttribute.format = VK_FORMAT_R16G16B16A16_UNORM;
+		positionAttribute.offset = offsetof(PackedVertex, position);
+
+		//Octahedral normal will be stored at Location 1
+		VkVertexInputAttributeDescription normalAttribute = {};
+		normalAttribute.binding = 0;
+		normalAttribute.location = 1;
+		normalAttribute.format = VK_FORMAT_R8G8_SNORM;
+		normalAttribute.offset = offsetof(PackedVertex, normal);
+
+		//UV will be stored at Location 3, Location 2 (color) is rebuilt from the normal
+		VkVertexInputAttributeDescription uvAttribute = {};
+		uvAttribute.binding = 0;
+		uvAttribute.location = 3;
+		uvAttribute.format = VK_FORMAT_R16G16_SFLOAT;
+		uvAttribute.offset = offsetof(PackedVertex, uv);
+
+		description.attributes.push_back(positionAttribute);
+		description.attributes.push_back(normalAttribute);
+		description.attributes.push_back(uvAttribute);
+		return description;
+	}
+
+	PackedVertex PackedVertex::pack(const Vertex& vertex, const glm::vec3& boundsMin, const glm::vec3& boundsExtent)
+	{
+		PackedVertex packed{};
+		glm::vec3 position = (vertex.position - boundsMin) / boundsExtent;
+		for (int i = 0; i < 3; ++i)
+			packed.position[i] = glm::packUnorm1x16(position[i]);
+
+		// Octahedral mapping: project on the octahedron |x| + |y| + |z| = 1 then fold the lower half
+		glm::vec3 normal = vertex.normal;
+		float length = glm::abs(normal.x) + glm::abs(normal.y) + glm::abs(normal.z);
+		glm::vec2 octahedral(0.f);
+		if (length > 0.f)
+		{
+			normal /= length;
+			octahedral = glm::vec2(normal.x, normal.y);
+			if (normal.z < 0.f)
+			{
+				octahedral.x = (1.f - glm::abs(normal.y)) * (normal.x >= 0.f ? 1.f : -1.f);
+				octahedral.y = (1.f - glm::abs(normal.x)) * (normal.y >= 0.f ? 1.f : -1.f);
+			}
+		}
+		packed.normal[0] = glm::packSnorm1x8(octahedral.x);
+		packed.normal[1] = glm::packSnorm1x8(octahedral.y);
+
+		packed.uv[0] = glm::packHalf1x16(vertex.uv.x);
+		packed.uv[1] = glm::packHalf1x16(vertex.uv.y);
+		return packed;
+	}
+
+	bool Vertex::operator==(const Vertex& other) const
+	{
+		// color is derived from the normal, it does not take part in the vertex identity
+		return position == other.position && normal == other.normal && uv == other.uv;
+	}
+}
+
+std::size_t std::hash<Concerto::Graphics::Wrapper::Vertex>::operator()(
+		const Concerto::Graphics::Wrapper::Vertex& vertex) const noexcept
+{
+	const float values[] = { vertex.position.x, vertex.position.y, vertex.position.z,
+							 vertex.normal.x, vertex.normal.y, vertex.normal.z,
+							 vertex.uv.x, vertex.uv.y };
+	std::size_t seed = 0;
+	std::hash<float> hasher;
+	for (float value : values)
+		seed ^= hasher(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	return seed;
 }
\ No newline at end of file
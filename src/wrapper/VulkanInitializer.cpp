@@ -269,6 +269,22 @@ namespace VulkanInitializer
 		return info;
 	}
 
+	VkCommandBufferInheritanceInfo
+	CommandBufferInheritanceInfo(VkRenderPass renderPass, std::uint32_t subpass, VkFramebuffer framebuffer)
+	{
+		VkCommandBufferInheritanceInfo info = {};
+		info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		info.pNext = nullptr;
+
+		info.renderPass = renderPass;
+		info.subpass = subpass;
+		info.framebuffer = framebuffer;
+		info.occlusionQueryEnable = VK_FALSE;
+		info.queryFlags = 0;
+		info.pipelineStatistics = 0;
+		return info;
+	}
+
 	VkFramebufferCreateInfo FramebufferCreateInfo(VkRenderPass renderPass, VkExtent2D extent)
 	{
 		VkFramebufferCreateInfo info = {};
@@ -1,5 +1,15 @@
 add_rules("mode.debug")
-add_requires('vulkan-headers' ,'vulkan-loader','vulkan-memory-allocator','vk-bootstrap','glm','stb',"glfw", "vulkan-validationlayers")
+add_requires('vulkan-headers' ,'vulkan-loader','vulkan-memory-allocator','vk-bootstrap','glm','stb',"glfw", "vulkan-validationlayers", 'nlohmann_json')
+
+option("avx2")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Build the bounds kernels with AVX2 instead of SSE2")
+option_end()
+
+if has_config("avx2") then
+    add_vectorexts("avx2")
+end
 
 target("ConcertoGraphics")
     set_kind("binary")
@@ -12,10 +22,33 @@ target("ConcertoGraphics")
     set_optimize("none")
     add_files('src/*.cpp', 'src/wrapper/*.cpp', 'src/window/*.cpp')
     add_includedirs('include', 'include/thirdParty', 'include/window')
-    add_packages('vulkan-headers', 'vulkan-loader', 'vulkan-memory-allocator', 'vk-bootstrap', 'glm', 'stb', 'glfw', "vulkan-validationlayers")
+    add_packages('vulkan-headers', 'vulkan-loader', 'vulkan-memory-allocator', 'vk-bootstrap', 'glm', 'stb', 'glfw', "vulkan-validationlayers", 'nlohmann_json')
     add_rules('utils.glsl2spv', {outputdir = '$(buildir)/$(plat)/$(arch)/$(mode)/shaders'})
-    add_files('shaders/*.vert', 'shaders/*.frag')
+    add_files('shaders/*.vert', 'shaders/*.frag', 'shaders/*.comp')
     add_packages('glslang')
     after_build(function (target)
         os.cp("./assets/", path.join(target:installdir(), "assets"))
     end)
+
+target("BoundingVolumeBenchmark")
+    set_kind("binary")
+    set_languages("cxx20")
+    set_optimize("fastest")
+    add_files('benchmark/BoundingVolumeBenchmark.cpp', 'src/wrapper/BoundingVolume.cpp', 'src/wrapper/Vertex.cpp')
+    add_includedirs('include')
+    add_packages('vulkan-headers', 'glm')
+
+target("ObjParserBenchmark")
+    set_kind("binary")
+    set_languages("cxx20")
+    set_optimize("fastest")
+    add_files('benchmark/ObjParserBenchmark.cpp', 'src/wrapper/ObjParser.cpp', 'src/wrapper/MappedFile.cpp', 'src/wrapper/Vertex.cpp')
+    add_includedirs('include', 'include/thirdParty')
+    add_packages('vulkan-headers', 'glm')
+
+target("MeshletCheck")
+    set_kind("binary")
+    set_languages("cxx20")
+    add_files('benchmark/MeshletCheck.cpp', 'src/wrapper/Meshlet.cpp', 'src/wrapper/BoundingVolume.cpp', 'src/wrapper/Vertex.cpp')
+    add_includedirs('include')
+    add_packages('vulkan-headers', 'glm')